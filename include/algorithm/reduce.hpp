@@ -0,0 +1,440 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../internal/scope_guard.hpp"
+#include "../macro/assert.hpp"
+#include "select.hpp"
+
+namespace frank {
+// Columns are split into chunks of this many rows. The split depends only on
+// the column size, never on the number of threads, so every reduction folds
+// the same partial results in the same order and returns the same value on
+// any machine. Columns of a single chunk never leave the calling thread.
+inline constexpr size_t reduce_chunk_rows = 16384;
+
+struct ReduceOptions {
+    // 0 uses std::thread::hardware_concurrency().
+    size_t threads {0};
+
+    size_t chunk_rows {reduce_chunk_rows};
+};
+
+namespace internal {
+template <typename Op, typename Acc, typename T>
+concept ReduceOp = requires(Op op, Acc acc, const T& item) {
+    { std::invoke(op, std::move(acc), item) } -> std::convertible_to<Acc>;
+};
+
+template <typename Combine, typename Acc>
+concept CombineOp = requires(Combine combine, Acc a, Acc b) {
+    { std::invoke(combine, std::move(a), std::move(b)) }
+    -> std::convertible_to<Acc>;
+};
+
+template <typename R>
+concept ColumnRange
+    = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>;
+
+template <ColumnRange R>
+using column_span_t = std::span<const std::ranges::range_value_t<R>>;
+
+// Folds a chunk with four independent accumulators, one per contiguous
+// quarter, and combines them in order. Breaking the single dependency chain
+// lets the compiler keep four lanes in flight, and since every lane covers a
+// contiguous run of items neither `op` nor `combine` has to be commutative.
+template <typename Acc, typename T, typename Op, typename Combine>
+[[nodiscard]] Acc reduce_chunk(
+    const T* items, size_t n, const Acc& identity, Op& op, Combine& combine) {
+    if (n < 16) {
+        Acc acc(identity);
+        for (size_t i = 0; i < n; ++i) {
+            acc = std::invoke(op, std::move(acc), items[i]);
+        }
+
+        return acc;
+    }
+
+    const size_t quarter = n / 4;
+
+    const T* i0 = items;
+    const T* i1 = items + quarter;
+    const T* i2 = items + 2 * quarter;
+    const T* i3 = items + 3 * quarter;
+
+    Acc a0(identity);
+    Acc a1(identity);
+    Acc a2(identity);
+    Acc a3(identity);
+
+    for (size_t i = 0; i < quarter; ++i) {
+        a0 = std::invoke(op, std::move(a0), i0[i]);
+        a1 = std::invoke(op, std::move(a1), i1[i]);
+        a2 = std::invoke(op, std::move(a2), i2[i]);
+        a3 = std::invoke(op, std::move(a3), i3[i]);
+    }
+
+    for (size_t i = quarter; i < n - 3 * quarter; ++i) {
+        a3 = std::invoke(op, std::move(a3), i3[i]);
+    }
+
+    a0 = std::invoke(combine, std::move(a0), std::move(a1));
+    a2 = std::invoke(combine, std::move(a2), std::move(a3));
+
+    return std::invoke(combine, std::move(a0), std::move(a2));
+}
+
+// The worker threads shared by every reduction, started on first use so a
+// per tick aggregate does not pay for creating threads. A reduction posts its
+// chunks as a job and works on them itself; idle workers join in until the
+// job has as many threads as it asked for. Chunks are claimed one at a time,
+// so a reduction run from inside a worker never waits on another job.
+//
+// Like SizeClassHeap, the pool is never destroyed; its threads stay parked
+// on the condition variable for the rest of the program.
+class ReduceWorkers {
+public:
+    struct Job {
+        void (*run)(void*, size_t);
+        void*  fn;
+        size_t chunks;
+
+        // Workers that may still join, and workers currently inside work().
+        // Both are guarded by the pool mutex.
+        size_t helpers;
+        size_t active {0};
+
+        std::atomic<size_t> next {0};
+
+        void work() {
+            for (;;) {
+                const size_t c = next.fetch_add(1, std::memory_order_relaxed);
+                if (c >= chunks) {
+                    return;
+                }
+
+                run(fn, c);
+            }
+        }
+    };
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_work;
+    std::condition_variable m_idle;
+    std::vector<Job*>       m_jobs;
+    size_t                  m_workers;
+
+    ReduceWorkers()
+        : m_workers(std::max<size_t>(std::thread::hardware_concurrency(), 1)
+                    - 1) {
+        for (size_t t = 0; t < m_workers; ++t) {
+            std::thread([this]() { serve(); }).detach();
+        }
+    }
+
+public:
+    [[nodiscard]] static ReduceWorkers& instance() {
+        static ReduceWorkers* workers = new ReduceWorkers();
+        return *workers;
+    }
+
+    [[nodiscard]] size_t worker_count() const noexcept { return m_workers; }
+
+    // Runs every chunk of `job` on the calling thread and up to job.helpers
+    // workers. Returns once no worker is left inside the job.
+    void run(Job& job) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push_back(&job);
+        }
+
+        m_work.notify_all();
+
+        ScopeGuard guard([this, &job]() noexcept { finish(job); });
+        job.work();
+    }
+
+private:
+    void finish(Job& job) noexcept {
+        job.next.store(job.chunks, std::memory_order_relaxed);
+
+        std::unique_lock lock(m_mutex);
+
+        auto it = std::find(m_jobs.begin(), m_jobs.end(), &job);
+        if (it != m_jobs.end()) {
+            m_jobs.erase(it);
+        }
+
+        m_idle.wait(lock, [&job]() { return job.active == 0; });
+    }
+
+    void serve() {
+        std::unique_lock lock(m_mutex);
+
+        for (;;) {
+            m_work.wait(lock, [this]() { return !m_jobs.empty(); });
+
+            Job* job = m_jobs.front();
+            ++job->active;
+
+            if (--job->helpers == 0) {
+                m_jobs.erase(m_jobs.begin());
+            }
+
+            lock.unlock();
+            job->work();
+            lock.lock();
+
+            if (--job->active == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+};
+
+// Runs `fn(chunk_idx)` for every chunk on the calling thread and at most
+// `threads - 1` pool workers.
+template <typename Fn>
+void for_each_chunk(size_t chunks, size_t threads, Fn& fn) {
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::min(threads, chunks);
+
+    const size_t helpers
+        = threads <= 1
+              ? 0
+              : std::min(threads - 1, ReduceWorkers::instance().worker_count());
+
+    if (helpers == 0) {
+        for (size_t c = 0; c < chunks; ++c) {
+            fn(c);
+        }
+
+        return;
+    }
+
+    ReduceWorkers::Job job {
+        .run     = [](void* f, size_t c) { (*static_cast<Fn*>(f))(c); },
+        .fn      = static_cast<void*>(std::addressof(fn)),
+        .chunks  = chunks,
+        .helpers = helpers,
+    };
+
+    ReduceWorkers::instance().run(job);
+}
+
+// Splits `column` into chunks, folds each one on its own thread starting
+// from `identity` and combines the partial results in chunk order.
+template <typename Acc, typename T, typename Op, typename Combine>
+[[nodiscard]] Acc reduce_column(
+    std::span<const T> column,
+    const Acc&         identity,
+    Op&                op,
+    Combine&           combine,
+    ReduceOptions      options) {
+    FRANK_ASSERT(options.chunk_rows != 0);
+
+    const size_t chunks
+        = (column.size() + options.chunk_rows - 1) / options.chunk_rows;
+
+    if (chunks <= 1) {
+        return reduce_chunk(
+            column.data(), column.size(), identity, op, combine);
+    }
+
+    std::vector<std::optional<Acc>> partials(chunks);
+
+    auto fold = [&](size_t c) {
+        const size_t first = c * options.chunk_rows;
+        const size_t n
+            = std::min(options.chunk_rows, column.size() - first);
+
+        partials[c].emplace(reduce_chunk(
+            column.data() + first, n, identity, op, combine));
+    };
+
+    for_each_chunk(chunks, options.threads, fold);
+
+    Acc acc(std::move(*partials[0]));
+    for (size_t c = 1; c < chunks; ++c) {
+        acc = std::invoke(combine, std::move(acc), std::move(*partials[c]));
+    }
+
+    return acc;
+}
+}
+
+// Reduces a column in parallel. Every chunk starts from a copy of `identity`
+// and folds its items with op(acc, item); the partial results are then
+// merged in chunk order with combine(acc, acc). `combine` must be associative
+// and `identity` must leave a value unchanged when combined with it, as 0
+// does for addition. For a sum of squares:
+//
+//   reduce(column, 0.0, [](double a, double x) { return a + x * x; },
+//          std::plus<> {});
+//
+// Neither operation has to be commutative.
+template <typename T, typename Acc, typename Op, typename Combine>
+    requires std::copy_constructible<Acc> && internal::ReduceOp<Op, Acc, T>
+             && internal::CombineOp<Combine, Acc>
+[[nodiscard]] Acc reduce(
+    std::span<const T> column,
+    Acc                identity,
+    Op                 op,
+    Combine            combine,
+    ReduceOptions      options = {}) {
+    return internal::reduce_column(column, identity, op, combine, options);
+}
+
+template <internal::ColumnRange R, typename Acc, typename Op, typename Combine>
+[[nodiscard]] Acc reduce(
+    const R&      column,
+    Acc           identity,
+    Op            op,
+    Combine       combine,
+    ReduceOptions options = {}) {
+    return reduce(
+        internal::column_span_t<R>(column),
+        std::move(identity),
+        std::move(op),
+        std::move(combine),
+        options);
+}
+
+template <typename T>
+    requires requires(const T& a, const T& b) {
+        { a + b } -> std::convertible_to<T>;
+    }
+[[nodiscard]] T sum(
+    std::span<const T> column, T init = T {}, ReduceOptions options = {}) {
+    return std::move(init)
+           + reduce(column, T {}, std::plus<> {}, std::plus<> {}, options);
+}
+
+template <internal::ColumnRange R>
+[[nodiscard]] auto sum(
+    const R&                      column,
+    std::ranges::range_value_t<R> init = {},
+    ReduceOptions                 options = {}) {
+    return sum(internal::column_span_t<R>(column), std::move(init), options);
+}
+
+// The first row is its own identity under min and max, so every chunk starts
+// from it.
+template <typename T>
+    requires std::totally_ordered<T>
+[[nodiscard]] std::optional<T>
+min(std::span<const T> column, ReduceOptions options = {}) {
+    if (column.empty()) {
+        return std::nullopt;
+    }
+
+    auto op = [](const T& a, const T& b) { return b < a ? b : a; };
+
+    return reduce(column.subspan(1), column[0], op, op, options);
+}
+
+template <internal::ColumnRange R>
+[[nodiscard]] auto min(const R& column, ReduceOptions options = {}) {
+    return min(internal::column_span_t<R>(column), options);
+}
+
+template <typename T>
+    requires std::totally_ordered<T>
+[[nodiscard]] std::optional<T>
+max(std::span<const T> column, ReduceOptions options = {}) {
+    if (column.empty()) {
+        return std::nullopt;
+    }
+
+    auto op = [](const T& a, const T& b) { return a < b ? b : a; };
+
+    return reduce(column.subspan(1), column[0], op, op, options);
+}
+
+template <internal::ColumnRange R>
+[[nodiscard]] auto max(const R& column, ReduceOptions options = {}) {
+    return max(internal::column_span_t<R>(column), options);
+}
+
+// Counts the rows for which `cmp(row, value)` holds. Uses the same branchless
+// compare as select(), so float columns take the SIMD path.
+template <typename T, typename Compare>
+    requires internal::ColumnPredicate<Compare, T>
+[[nodiscard]] size_t count(
+    std::span<const T> column,
+    Compare            cmp,
+    const T&           value,
+    ReduceOptions      options = {}) {
+    FRANK_ASSERT(options.chunk_rows != 0);
+
+    if (column.empty()) {
+        return 0;
+    }
+
+    const size_t chunks
+        = (column.size() + options.chunk_rows - 1) / options.chunk_rows;
+
+    std::vector<size_t> partials(chunks, 0);
+
+    auto count_chunk = [&](size_t c) {
+        const size_t first = c * options.chunk_rows;
+        const size_t n
+            = std::min(options.chunk_rows, column.size() - first);
+
+        SelectionWord bitmap[reduce_chunk_rows / selection_word_bits];
+        size_t        total = 0;
+
+        for (size_t done = 0; done < n; done += reduce_chunk_rows) {
+            const size_t rows = std::min(reduce_chunk_rows, n - done);
+
+            total += select(
+                column.subspan(first + done, rows),
+                cmp,
+                value,
+                std::span<SelectionWord>(bitmap));
+        }
+
+        partials[c] = total;
+    };
+
+    internal::for_each_chunk(chunks, options.threads, count_chunk);
+
+    size_t total = 0;
+    for (size_t partial : partials) {
+        total += partial;
+    }
+
+    return total;
+}
+template <internal::ColumnRange R, typename Compare>
+[[nodiscard]] size_t count(
+    const R&                             column,
+    Compare                              cmp,
+    const std::ranges::range_value_t<R>& value,
+    ReduceOptions                        options = {}) {
+    return count(
+        internal::column_span_t<R>(column), std::move(cmp), value, options);
+}
+}
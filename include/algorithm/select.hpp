@@ -0,0 +1,212 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+#include "../container/dynamic_array.hpp"
+#include "../macro/assert.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace frank {
+// A selection bitmap stores one bit per row, packed into 64 bit words. Bit i
+// of word w describes row w * 64 + i. Bits past the end of the column are
+// always zero, so the bitmap can be combined with other bitmaps of the same
+// column using plain word-wise and/or.
+using SelectionWord = std::uint64_t;
+
+inline constexpr size_t selection_word_bits = 64;
+
+[[nodiscard]] constexpr size_t selection_words(size_t rows) noexcept {
+    return (rows + selection_word_bits - 1) / selection_word_bits;
+}
+
+namespace internal {
+template <typename Compare, typename T>
+concept ColumnPredicate = requires(Compare cmp, const T& a, const T& b) {
+    { cmp(a, b) } -> std::convertible_to<bool>;
+};
+
+// Builds one bitmap word without branching on the predicate result. The
+// fixed trip count lets the compiler unroll and vectorize the compare.
+template <typename T, typename Compare>
+[[nodiscard]] inline SelectionWord select_word(
+    const T* items, size_t n, Compare& cmp, const T& value) noexcept {
+    SelectionWord word = 0;
+
+    for (size_t bit = 0; bit < n; ++bit) {
+        word |= static_cast<SelectionWord>(static_cast<bool>(
+                    std::invoke(cmp, items[bit], value)))
+                << bit;
+    }
+
+    return word;
+}
+
+#if defined(__SSE2__)
+template <typename Compare>
+concept SimdFloatCompare = std::same_as<Compare, std::less<>>
+                           || std::same_as<Compare, std::less<float>>
+                           || std::same_as<Compare, std::less_equal<>>
+                           || std::same_as<Compare, std::less_equal<float>>
+                           || std::same_as<Compare, std::greater<>>
+                           || std::same_as<Compare, std::greater<float>>
+                           || std::same_as<Compare, std::greater_equal<>>
+                           || std::same_as<Compare, std::greater_equal<float>>
+                           || std::same_as<Compare, std::equal_to<>>
+                           || std::same_as<Compare, std::equal_to<float>>;
+
+template <typename Compare>
+[[nodiscard]] inline __m128 simd_compare(__m128 a, __m128 b) noexcept {
+    if constexpr (
+        std::same_as<Compare, std::less<>>
+        || std::same_as<Compare, std::less<float>>) {
+        return _mm_cmplt_ps(a, b);
+    } else if constexpr (
+        std::same_as<Compare, std::less_equal<>>
+        || std::same_as<Compare, std::less_equal<float>>) {
+        return _mm_cmple_ps(a, b);
+    } else if constexpr (
+        std::same_as<Compare, std::greater<>>
+        || std::same_as<Compare, std::greater<float>>) {
+        return _mm_cmpgt_ps(a, b);
+    } else if constexpr (
+        std::same_as<Compare, std::greater_equal<>>
+        || std::same_as<Compare, std::greater_equal<float>>) {
+        return _mm_cmpge_ps(a, b);
+    } else {
+        return _mm_cmpeq_ps(a, b);
+    }
+}
+
+// Full 64 row word, four lanes per compare. movemask packs the lane results
+// straight into bits, so no per-row work is left.
+template <typename Compare>
+[[nodiscard]] inline SelectionWord
+select_word_simd(const float* items, float value) noexcept {
+    const __m128  v    = _mm_set1_ps(value);
+    SelectionWord word = 0;
+
+    for (size_t i = 0; i < selection_word_bits; i += 4) {
+        const __m128 mask = simd_compare<Compare>(_mm_loadu_ps(items + i), v);
+        word |= static_cast<SelectionWord>(_mm_movemask_ps(mask)) << i;
+    }
+
+    return word;
+}
+#endif
+}
+
+// Evaluates `cmp(row, value)` for every row of the column and writes the
+// result as a selection bitmap. The bitmap must hold at least
+// selection_words(column.size()) words. Returns the number of selected rows.
+template <typename T, typename Compare>
+    requires internal::ColumnPredicate<Compare, T>
+size_t select(
+    std::span<const T>       column,
+    Compare                  cmp,
+    const T&                 value,
+    std::span<SelectionWord> bitmap) noexcept {
+    FRANK_ASSERT(bitmap.size() >= selection_words(column.size()));
+
+    const size_t full  = column.size() / selection_word_bits;
+    const size_t tail  = column.size() % selection_word_bits;
+    size_t       count = 0;
+
+    for (size_t w = 0; w < full; ++w) {
+        const T* items = column.data() + w * selection_word_bits;
+
+        SelectionWord word;
+#if defined(__SSE2__)
+        if constexpr (
+            std::same_as<T, float> && internal::SimdFloatCompare<Compare>) {
+            word = internal::select_word_simd<Compare>(items, value);
+        } else {
+            word = internal::select_word(
+                items, selection_word_bits, cmp, value);
+        }
+#else
+        word = internal::select_word(items, selection_word_bits, cmp, value);
+#endif
+
+        bitmap[w] = word;
+        count += std::popcount(word);
+    }
+
+    if (tail != 0) {
+        const SelectionWord word = internal::select_word(
+            column.data() + full * selection_word_bits, tail, cmp, value);
+
+        bitmap[full] = word;
+        count += std::popcount(word);
+    }
+
+    return count;
+}
+
+// Turns a selection bitmap into a list of row indices, written to `out` in
+// ascending order. `out` must have room for every selected row. Returns the
+// number of indices written.
+template <typename Index>
+    requires std::unsigned_integral<Index>
+size_t compress(
+    std::span<const SelectionWord> bitmap, std::span<Index> out) noexcept {
+    size_t n = 0;
+
+    for (size_t w = 0; w < bitmap.size(); ++w) {
+        SelectionWord word = bitmap[w];
+        const Index   base = static_cast<Index>(w * selection_word_bits);
+
+        while (word != 0) {
+            FRANK_ASSERT(n < out.size());
+
+            out[n++] = base + static_cast<Index>(std::countr_zero(word));
+            word &= word - 1;
+        }
+    }
+
+    return n;
+}
+
+// Appends the indices of all selected rows to `out`. Reserves once for the
+// whole selection.
+template <typename Index, typename Allocator, typename GrowthPolicy>
+    requires std::unsigned_integral<Index>
+void compress(
+    std::span<const SelectionWord>                bitmap,
+    DynamicArray<Index, Allocator, GrowthPolicy>& out) {
+    size_t count = 0;
+    for (SelectionWord word : bitmap) {
+        count += std::popcount(word);
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    if (out.size() + count > out.capacity()) {
+        out.grow(out.size() + count);
+    }
+
+    for (size_t w = 0; w < bitmap.size(); ++w) {
+        SelectionWord word = bitmap[w];
+        const Index   base = static_cast<Index>(w * selection_word_bits);
+
+        while (word != 0) {
+            out.push_back(base + static_cast<Index>(std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+}
+}
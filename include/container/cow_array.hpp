@@ -0,0 +1,182 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "../macro/assert.hpp"
+#include "dynamic_array.hpp"
+
+namespace frank {
+namespace internal {
+template <typename T>
+inline constexpr size_t cow_default_chunk_rows
+    = std::max<size_t>(1, 16384 / sizeof(T));
+}
+
+// A column split into fixed size chunks that are shared between forks.
+// fork() only copies the chunk pointers; a chunk is duplicated the first time
+// one of its owners writes to it, so a fork that touches a few rows pays for
+// a few chunks instead of the whole column.
+//
+// Reads go through the const accessors and never copy. Every mutable accessor
+// first makes the chunk it touches unique to this array.
+template <
+    typename T,
+    size_t ChunkRows   = internal::cow_default_chunk_rows<T>,
+    typename Allocator = std::allocator<T>>
+    requires(ChunkRows != 0)
+class CowArray {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+
+    static constexpr size_type chunk_rows = ChunkRows;
+
+private:
+    using Chunk = DynamicArray<T, Allocator>;
+
+    DynamicArray<std::shared_ptr<Chunk>> m_chunks;
+    size_type                            m_size {0};
+    Allocator                            m_allocator;
+
+public:
+    ~CowArray() = default;
+
+    CowArray() = default;
+
+    explicit CowArray(const Allocator& a)
+        : m_allocator(a) { }
+
+    CowArray(const CowArray&)            = delete;
+    CowArray& operator=(const CowArray&) = delete;
+
+    CowArray(CowArray&&)            = default;
+    CowArray& operator=(CowArray&&) = default;
+
+    // Returns a new array with the same items that shares every chunk with
+    // this one. Costs one reference count increment per chunk.
+    [[nodiscard]] CowArray fork() const {
+        CowArray other(m_allocator);
+        other.m_chunks = m_chunks;
+        other.m_size   = m_size;
+
+        return other;
+    }
+
+public:
+    const_reference operator[](size_type idx) const noexcept {
+        FRANK_ASSERT(idx < m_size);
+        return (*m_chunks[idx / ChunkRows])[idx % ChunkRows];
+    }
+
+    [[nodiscard]] std::optional<const_reference>
+    at(size_type idx) const noexcept {
+        return idx < m_size ? std::optional<const_reference>((*this)[idx]) :
+                              std::nullopt;
+    }
+
+    // Returns a mutable reference, duplicating the owning chunk if it is
+    // still shared with a fork.
+    reference write(size_type idx) {
+        FRANK_ASSERT(idx < m_size);
+        return unique_chunk(idx / ChunkRows)[idx % ChunkRows];
+    }
+
+    [[nodiscard]] std::span<const T> chunk(size_type c) const noexcept {
+        FRANK_ASSERT(c < chunk_count());
+
+        const Chunk& items = *m_chunks[c];
+        return std::span<const T>(items.cbegin(), items.cend());
+    }
+
+    // Mutable view of a whole chunk, for systems that rewrite every row.
+    [[nodiscard]] std::span<T> chunk_mut(size_type c) {
+        FRANK_ASSERT(c < chunk_count());
+
+        Chunk& items = unique_chunk(c);
+        return std::span<T>(items.begin(), items.end());
+    }
+
+    [[nodiscard]] size_type chunk_count() const noexcept {
+        return m_chunks.size();
+    }
+
+    // True if chunk `c` is not shared with any fork, so writing to it will
+    // not copy.
+    [[nodiscard]] bool is_chunk_unique(size_type c) const noexcept {
+        FRANK_ASSERT(c < chunk_count());
+        return m_chunks[c].use_count() == 1;
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] size_type size() const noexcept { return m_size; }
+
+    [[nodiscard]] Allocator allocator() const noexcept { return m_allocator; }
+
+public:
+    void push_back(const T& item) { emplace_back(item); }
+
+    void push_back(T&& item) { emplace_back(std::move(item)); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        if (m_size % ChunkRows == 0) {
+            m_chunks.push_back(std::allocate_shared<Chunk>(
+                m_allocator, ChunkRows, m_allocator));
+        }
+
+        unique_chunk(m_size / ChunkRows)
+            .emplace_back(std::forward<Args>(args)...);
+        ++m_size;
+    }
+
+    void pop_back() {
+        FRANK_ASSERT(!is_empty());
+
+        --m_size;
+
+        if (m_size % ChunkRows == 0) {
+            m_chunks.pop_back();
+            return;
+        }
+
+        unique_chunk(m_size / ChunkRows).pop_back();
+    }
+
+    void clear() noexcept {
+        m_chunks.clear();
+        m_size = 0;
+    }
+
+private:
+    Chunk& unique_chunk(size_type c) {
+        std::shared_ptr<Chunk>& chunk = m_chunks[c];
+
+        if (chunk.use_count() != 1) {
+            std::shared_ptr<Chunk> copy
+                = std::allocate_shared<Chunk>(m_allocator, m_allocator);
+
+            copy->reserve(ChunkRows);
+            copy->assign(chunk->cbegin(), chunk->cend());
+
+            chunk = std::move(copy);
+        }
+
+        return *chunk;
+    }
+};
+}
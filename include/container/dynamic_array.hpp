@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 // See LICENSE.md file in the project root for full license information.
 
+#pragma once
+
 #include <algorithm>
 #include <cassert>
 #include <compare>
@@ -15,17 +17,30 @@
 #include <memory>
 #include <new>
 #include <optional>
+#include <ranges>
 #include <type_traits>
 #include <utility>
 
 #include "../internal/scope_guard.hpp"
 #include "../internal/type_traits.hpp"
 #include "../macro/assert.hpp"
+#include "growth_policy.hpp"
 
 namespace frank {
-template <typename T, typename Allocator = std::allocator<T>>
+// Tag for constructors that take ownership of memory which was not allocated
+// by the container itself.
+struct AdoptStorage {
+    explicit AdoptStorage() = default;
+};
+
+inline constexpr AdoptStorage adopt_storage {};
+
+template <
+    typename T,
+    typename Allocator    = std::allocator<T>,
+    typename GrowthPolicy = GrowDouble<>>
     requires std::copy_constructible<T> && std::move_constructible<T>
-             && std::destructible<T>
+             && std::destructible<T> && internal::IsGrowthPolicy<GrowthPolicy>
 class DynamicArray {
 public:
     using value_type      = T;
@@ -34,6 +49,7 @@ public:
     using size_type       = size_t;
     using difference_type = std::ptrdiff_t;
     using allocator_type  = Allocator;
+    using growth_policy   = GrowthPolicy;
     using pointer         = std::allocator_traits<Allocator>::pointer;
     using const_pointer   = std::allocator_traits<Allocator>::const_pointer;
 
@@ -92,13 +108,29 @@ private:
         }
 
         void swap_with_allocator(Impl& other) noexcept {
-            std::swap(*this, other);
+            std::swap(
+                static_cast<Allocator&>(*this),
+                static_cast<Allocator&>(other));
+            swap_without_allocator(other);
         }
 
+        // Allocates room for at least `sz` items. Allocators that implement
+        // allocate_at_least may round the block up (see AlignedAllocator);
+        // the extra room becomes usable capacity.
         void init_self(size_type sz) {
             FRANK_ASSERT(sz != 0);
 
-            first    = std::allocator_traits<Allocator>::allocate(*this, sz);
+            if constexpr (internal::HasAllocateAtLeast<Allocator, size_type>) {
+                auto result
+                    = static_cast<Allocator&>(*this).allocate_at_least(sz);
+                FRANK_ASSERT(result.count >= sz);
+
+                first = result.ptr;
+                sz    = result.count;
+            } else {
+                first = std::allocator_traits<Allocator>::allocate(*this, sz);
+            }
+
             last     = first;
             capacity = first;
 
@@ -111,6 +143,23 @@ private:
             capacity = nullptr;
         }
 
+        // Resizes the block in place through the allocator's reallocate().
+        // Only valid for types that may be copied bytewise.
+        void reallocate_self(size_type sz) {
+            FRANK_ASSERT(!is_null());
+            FRANK_ASSERT(sz != 0);
+
+            const size_type n = std::distance(first, last);
+
+            first = static_cast<Allocator&>(*this).reallocate(
+                first, std::distance(first, capacity), sz);
+            last     = first;
+            capacity = first;
+
+            std::advance(last, n);
+            std::advance(capacity, sz);
+        }
+
         void deallocate_self() noexcept {
             std::allocator_traits<Allocator>::deallocate(
                 static_cast<Allocator&>(*this),
@@ -127,6 +176,22 @@ private:
                 static_cast<Allocator&>(*this), p, std::forward<Args>(args)...);
         }
 
+        // Constructs `n` items at `dest` from `it`, `it + 1`, ... through the
+        // allocator, so items that take an allocator (std::pmr::string) end
+        // up on our resource. Destroys the items already built on failure.
+        template <typename It>
+        void construct_range(It it, size_type n, pointer dest) {
+            pointer p = dest;
+
+            internal::ScopeGuard guard([&]() { destroy_range(dest, p); });
+
+            for (; p != dest + n; ++p, ++it) {
+                construct_item(p, *it);
+            }
+
+            guard.dismiss();
+        }
+
         void destroy_self() noexcept(std::is_nothrow_destructible_v<T>) {
             destroy_range(first, last);
         }
@@ -153,11 +218,15 @@ private:
             }
         }
 
+        // Shifts [a, b) n slots to the right. Relocatable items are moved
+        // bytewise and the slots they leave behind count as uninitialized.
+        // Otherwise [b, b + n) must hold live items, which are move
+        // assigned over.
         void move_range_right(pointer a, pointer b, size_type n) noexcept(
-            std::is_nothrow_move_constructible_v<T>) {
+            std::is_nothrow_move_assignable_v<T>) {
             FRANK_ASSERT(is_valid_range(a, b));
 
-            if constexpr (std::is_trivially_move_constructible_v<T>) {
+            if constexpr (is_trivially_relocatable_v<T>) {
                 std::memmove(
                     static_cast<void*>(a + n),
                     static_cast<const void*>(a),
@@ -167,11 +236,13 @@ private:
             }
         }
 
+        // Shifts [a, b) n slots to the left, with the same rules as
+        // move_range_right.
         void move_range_left(pointer a, pointer b, size_type n) noexcept(
-            std::is_nothrow_move_constructible_v<T>) {
+            std::is_nothrow_move_assignable_v<T>) {
             FRANK_ASSERT(is_valid_range(a, b));
 
-            if constexpr (std::is_trivially_move_constructible_v<T>) {
+            if constexpr (is_trivially_relocatable_v<T>) {
                 std::memmove(
                     static_cast<void*>(a - n),
                     static_cast<const void*>(a),
@@ -221,27 +292,64 @@ public:
         grow(sz);
     }
 
+    // Takes ownership of `cap` slots starting at `first`, of which the first
+    // `sz` already hold constructed items. The block is later released
+    // through `a`, so `a` must be able to deallocate it. Allocators such as
+    // ExternalAllocator use this to wrap mapped or otherwise foreign memory
+    // without copying it.
+    DynamicArray(
+        AdoptStorage,
+        pointer          first,
+        size_type        sz,
+        size_type        cap,
+        const Allocator& a = Allocator())
+        noexcept(std::is_nothrow_copy_constructible_v<Allocator>)
+        : impl(a) {
+        FRANK_ASSERT(sz <= cap);
+        FRANK_ASSERT(first != nullptr || cap == 0);
+
+        impl.first    = first;
+        impl.last     = first + sz;
+        impl.capacity = first + cap;
+    }
+
     DynamicArray(const DynamicArray& other)
         : DynamicArray(
               other,
-              std::allocator_traits<T>::select_on_container_copy_construction(
-                  static_cast<const Allocator&>(other.impl))) { }
+              std::allocator_traits<Allocator>::
+                  select_on_container_copy_construction(
+                      static_cast<const Allocator&>(other.impl))) { }
 
-    DynamicArray(const DynamicArray& other, const Allocator& a = Allocator())
+    DynamicArray(const DynamicArray& other, const Allocator& a)
         : impl(a) {
+        if (other.is_empty()) {
+            return;
+        }
+
         grow(other.size());
         copy_range(other.impl.first, other.impl.last, impl.first);
+        impl.advance(other.size());
     }
 
     DynamicArray(DynamicArray&& other) noexcept(
-        std::is_nothrow_move_constructible_v<Allocator>) {
-        impl.swap_with_allocator(other.impl);
+        std::is_nothrow_move_constructible_v<Allocator>)
+        : impl(std::move(static_cast<Allocator&>(other.impl))) {
+        impl.swap_without_allocator(other.impl);
     }
 
-    DynamicArray(DynamicArray&& other, const Allocator& a) noexcept(
-        std::is_nothrow_constructible_v<Impl, decltype(a)>)
+    // Steals the storage of `other` when `a` can free it, otherwise moves the
+    // items one by one into storage from `a`.
+    DynamicArray(DynamicArray&& other, const Allocator& a)
         : impl(a) {
-        impl.swap_without_allocator(other.impl);
+        if (can_free_storage_of(other)) {
+            impl.swap_without_allocator(other.impl);
+            return;
+        }
+
+        append(
+            std::make_move_iterator(other.begin()),
+            std::make_move_iterator(other.end()));
+        other.clear();
     }
 
     DynamicArray(std::initializer_list<T> il, const Allocator& a = Allocator())
@@ -258,12 +366,18 @@ public:
 
     // TODO
     // Optimize
-    DynamicArray& operator=(DynamicArray other) {
-        if constexpr (std::allocator_traits<
-                          Allocator>::propagate_on_container_copy_assignment) {
-            impl.swap_with_allocator(other.impl);
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_copy_assignment::value) {
+            DynamicArray copy(other, static_cast<const Allocator&>(other.impl));
+            impl.swap_with_allocator(copy.impl);
         } else {
-            impl.swap_without_allocator(other.impl);
+            DynamicArray copy(other, static_cast<const Allocator&>(impl));
+            impl.swap_without_allocator(copy.impl);
         }
 
         return *this;
@@ -272,14 +386,21 @@ public:
     DynamicArray& operator=(DynamicArray&& other) noexcept(
         std::is_nothrow_destructible_v<T>
         && (std::allocator_traits<
-                Allocator>::propagate_on_container_move_assignment ?
+                Allocator>::propagate_on_container_move_assignment::value ?
                 std::is_nothrow_move_constructible_v<Allocator> :
-                true)) {
-        if constexpr (std::allocator_traits<
-                          Allocator>::propagate_on_container_move_assignment) {
+                std::allocator_traits<Allocator>::is_always_equal::value)) {
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_move_assignment::value) {
             impl.swap_with_allocator(other.impl);
-        } else {
+        } else if (can_free_storage_of(other)) {
             impl.swap_without_allocator(other.impl);
+        } else {
+            // The allocators differ and stay put (std::pmr), so the items
+            // have to move into storage from our own allocator.
+            clear();
+            append(
+                std::make_move_iterator(other.begin()),
+                std::make_move_iterator(other.end()));
         }
 
         if (!other.is_null()) {
@@ -420,7 +541,8 @@ public:
 
     [[nodiscard]] constexpr size_type max_size() const noexcept {
         if constexpr (internal::HasMaxSize<Allocator>) {
-            return std::allocator_traits<Allocator>::max_size();
+            return std::allocator_traits<Allocator>::max_size(
+                static_cast<const Allocator&>(impl));
         } else {
             return std::numeric_limits<size_type>::max();
         }
@@ -462,36 +584,132 @@ public:
         impl.destroy_item(impl.last);
     }
 
-    void insert(size_type idx, const T& item) noexcept(
-        std::is_nothrow_move_constructible_v<T>
-        && std::is_nothrow_constructible_v<T, T&&>) {
-        emplace(idx, item);
-    }
+    void insert(size_type idx, const T& item) { emplace(idx, item); }
 
-    void insert(size_type idx, T&& item) noexcept(
-        std::is_nothrow_move_constructible_v<T>
-        && std::is_nothrow_constructible_v<T, T&&>) {
-        emplace(idx, std::move(item));
-    }
+    void insert(size_type idx, T&& item) { emplace(idx, std::move(item)); }
 
     template <typename... Args>
-    void emplace(size_type idx, Args&&... args) noexcept(
-        std::is_nothrow_move_constructible_v<T>
-        && std::is_nothrow_constructible_v<T, Args...>) {
-        FRANK_ASSERT(is_idx_valid(idx));
+    void emplace(size_type idx, Args&&... args) {
+        FRANK_ASSERT(idx <= size());
+
+        if (idx == size()) {
+            emplace_back(std::forward<Args>(args)...);
+            return;
+        }
+
+        // Built up front, args may refer to items that are about to move.
+        T item(std::forward<Args>(args)...);
+
+        if (is_full()) {
+            grow(calc_next_capacity());
+        }
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            impl.move_range_right(impl.first + idx, impl.last, 1);
+            impl.construct_item(impl.first + idx, std::move(item));
+        } else {
+            impl.construct_item(impl.last, std::move(impl.last[-1]));
+            impl.move_range_right(impl.first + idx, impl.last - 1, 1);
+            impl.first[idx] = std::move(item);
+        }
 
-        impl.move_range_right(impl.first + idx + 1, impl.last, 1);
-        impl.construct_item(impl.first + idx, std::forward<Args>(args)...);
         impl.advance(1);
     }
 
+    // Appends every item of `r`. Sized and forward ranges reserve once for
+    // the whole batch; contiguous ranges of trivially copyable items are
+    // copied with a single memcpy. `r` must not refer to items of this array,
+    // reserving may move them before they are copied.
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void append_range(R&& r) {
+        if constexpr (
+            std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+            const size_type n
+                = static_cast<size_type>(std::ranges::distance(r));
+
+            if (n == 0) {
+                return;
+            }
+
+            reserve_for(n);
+
+            if constexpr (
+                std::ranges::contiguous_range<R>
+                && std::is_trivially_copyable_v<T>
+                && std::is_same_v<std::ranges::range_value_t<R>, T>) {
+                copy_range(
+                    std::ranges::data(r),
+                    std::ranges::data(r) + n,
+                    impl.last);
+            } else {
+                impl.construct_range(std::ranges::begin(r), n, impl.last);
+            }
+
+            impl.advance(n);
+        } else {
+            for (auto&& item : r) {
+                emplace_back(std::forward<decltype(item)>(item));
+            }
+        }
+    }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    void append(It a, It b) {
+        append_range(std::ranges::subrange(a, b));
+    }
+
+    // Inserts every item of `r` before `idx`, reserving once. `r` must not
+    // refer to items of this array.
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void insert_range(size_type idx, R&& r) {
+        FRANK_ASSERT(idx <= size());
+
+        if constexpr (
+            std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+            && std::is_trivially_copyable_v<T>
+            && std::is_same_v<std::ranges::range_value_t<R>, T>) {
+            const size_type n = std::ranges::size(r);
+
+            if (n == 0) {
+                return;
+            }
+
+            reserve_for(n);
+
+            impl.move_range_right(impl.first + idx, impl.last, n);
+            copy_range(
+                std::ranges::data(r),
+                std::ranges::data(r) + n,
+                impl.first + idx);
+            impl.advance(n);
+        } else {
+            // Append, then rotate the new items into place. Works for any
+            // range, including single pass ones, and only needs moves.
+            const size_type old_size = size();
+
+            append_range(std::forward<R>(r));
+            std::rotate(impl.first + idx, impl.first + old_size, impl.last);
+        }
+    }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    void insert(size_type idx, It a, It b) {
+        insert_range(idx, std::ranges::subrange(a, b));
+    }
+
     void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
 
     template <typename It>
         requires std::input_iterator<It>
                  && std::convertible_to<std::iter_value_t<It>, T>
     void assign(It a, It b) {
-        impl.destroy_self();
+        clear();
 
         size_type size = std::distance(a, b);
         if (size > capacity()) {
@@ -502,30 +720,29 @@ public:
             std::contiguous_iterator<It> && std::is_trivially_copyable_v<T>
             && std::is_trivially_copyable_v<std::iter_value_t<It>>
             && std::is_same_v<std::iter_value_t<It>, T>) {
-            copy_range(
-                reinterpret_cast<const_pointer>(a),
-                reinterpret_cast<const_pointer>(b),
-                impl.first);
+            copy_range(std::to_address(a), std::to_address(b), impl.first);
         } else {
-            std::copy(a, b, impl.first);
+            impl.construct_range(a, size, impl.first);
         }
 
-        impl.advance(size);
+        if (size != 0) {
+            impl.advance(size);
+        }
     }
 
     void erase(size_type idx) noexcept(
         std::is_nothrow_destructible_v<T>
-        && std::is_nothrow_move_constructible_v<T>) {
+        && std::is_nothrow_move_assignable_v<T>) {
         FRANK_ASSERT(is_idx_valid(idx));
 
-        if (idx == size() - 1) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            impl.destroy_item(impl.first + idx);
+            impl.move_range_left(impl.first + idx + 1, impl.last, 1);
+            impl.prev(1);
+        } else {
+            impl.move_range_left(impl.first + idx + 1, impl.last, 1);
             pop_back();
-            return;
         }
-
-        impl.destroy_item(impl.first + idx);
-        impl.move_range_left(impl.first + idx + 1, impl.last, 1);
-        impl.prev(1);
     }
 
     void clear() noexcept(std::is_nothrow_destructible_v<T>) {
@@ -533,6 +750,31 @@ public:
         impl.last = impl.first;
     }
 
+    // Changes the size to `sz` without value initializing new items. Items of
+    // trivially default constructible types are left indeterminate, so the
+    // caller must overwrite them (with read(), memcpy, a decoder, ...) before
+    // reading them. Other types are default constructed.
+    void resize_for_overwrite(size_type sz)
+        requires std::default_initializable<T>
+    {
+        if (sz <= size()) {
+            impl.destroy_range(impl.first + sz, impl.last);
+            impl.last = impl.first + sz;
+            return;
+        }
+
+        reserve_for(sz - size());
+
+        if constexpr (std::is_trivially_default_constructible_v<T>) {
+            impl.advance(sz - size());
+        } else {
+            while (size() < sz) {
+                impl.construct_item(impl.last);
+                impl.advance(1);
+            }
+        }
+    }
+
     void reserve(size_type sz) {
         FRANK_ASSERT(sz > size());
 
@@ -546,6 +788,13 @@ public:
     void grow(size_type sz) {
         FRANK_ASSERT(sz > capacity());
 
+        if constexpr (can_reallocate) {
+            if (!is_null()) {
+                impl.reallocate_self(sz);
+                return;
+            }
+        }
+
         Impl new_impl(static_cast<Allocator>(impl));
         new_impl.init_self(sz);
 
@@ -554,29 +803,56 @@ public:
             return;
         }
 
-        move_range(impl.first, impl.last, new_impl.first);
-        new_impl.advance(size());
+        if (!is_empty()) {
+            relocate_range(impl.first, impl.last, new_impl.first);
+            new_impl.advance(size());
+        }
 
         impl.swap_without_allocator(new_impl);
         new_impl.last = new_impl.first;
     }
 
-    void shrink_to_fit() { shrink(size()); }
+    void shrink_to_fit() {
+        if (size() < capacity()) {
+            shrink(size());
+        }
+    }
 
     void shrink(size_type sz) {
         FRANK_ASSERT(sz < capacity());
         FRANK_ASSERT(sz >= size());
 
+        if (sz == 0) {
+            impl.deallocate_self();
+            impl.init_self_null();
+            return;
+        }
+
+        if constexpr (can_reallocate) {
+            impl.reallocate_self(sz);
+            return;
+        }
+
         Impl new_impl(static_cast<Allocator>(impl));
         new_impl.init_self(sz);
 
-        move_range(impl.first, impl.last, new_impl.first);
+        if (!is_empty()) {
+            relocate_range(impl.first, impl.last, new_impl.first);
+            new_impl.advance(size());
+        }
 
-        impl.swap(new_impl);
+        impl.swap_without_allocator(new_impl);
         new_impl.last = new_impl.first;
     }
 
 private:
+    // Allocators that can resize a block in place (see MallocAllocator) let
+    // growth skip the allocate, copy, free round trip. The block is resized
+    // bytewise, so this is limited to trivially relocatable items.
+    static constexpr bool can_reallocate
+        = is_trivially_relocatable_v<T>
+          && internal::HasReallocate<Allocator, pointer, size_type>;
+
     void copy_range(const_pointer a, const_pointer b, pointer dest) noexcept(
         std::is_nothrow_copy_constructible_v<T>) {
         FRANK_ASSERT(std::distance(a, b) >= 0);
@@ -587,21 +863,25 @@ private:
                 static_cast<const void*>(a),
                 std::distance(a, b) * sizeof(T));
         } else {
-            std::uninitialized_copy(a, b, dest);
+            impl.construct_range(a, std::distance(a, b), dest);
         }
     }
 
-    void move_range(const_pointer a, const_pointer b, pointer dest) noexcept(
-        std::is_nothrow_move_constructible_v<T>) {
+    // Moves [a, b) into uninitialized memory at dest and ends the lifetime of
+    // the source items.
+    void relocate_range(pointer a, pointer b, pointer dest) noexcept(
+        std::is_nothrow_move_constructible_v<T>
+        && std::is_nothrow_destructible_v<T>) {
         FRANK_ASSERT(std::distance(a, b) >= 0);
 
-        if constexpr (std::is_trivially_copyable_v<T>) {
+        if constexpr (is_trivially_relocatable_v<T>) {
             std::memcpy(
                 static_cast<void*>(dest),
                 static_cast<const void*>(a),
                 std::distance(a, b) * sizeof(T));
         } else {
             std::uninitialized_move(a, b, dest);
+            impl.destroy_range(a, b);
         }
     }
 
@@ -615,7 +895,27 @@ private:
     }
 
     [[nodiscard]] inline size_type calc_next_capacity() noexcept {
-        return is_empty() ? 1 : capacity() * 2;
+        return GrowthPolicy::next_capacity(capacity(), sizeof(T));
+    }
+
+    // Whether our allocator may free storage allocated by that of `other`.
+    [[nodiscard]] bool
+    can_free_storage_of(const DynamicArray& other) const noexcept {
+        if constexpr (
+            std::allocator_traits<Allocator>::is_always_equal::value) {
+            return true;
+        } else {
+            return static_cast<const Allocator&>(impl)
+                   == static_cast<const Allocator&>(other.impl);
+        }
+    }
+
+    // Makes room for `n` more items with at most one reallocation, without
+    // giving up the geometric growth of the policy.
+    void reserve_for(size_type n) {
+        if (size() + n > capacity()) {
+            grow(std::max(size() + n, calc_next_capacity()));
+        }
     }
 };
 }
@@ -0,0 +1,88 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+
+namespace frank {
+// A growth policy decides the capacity a container grows to once it is full.
+// next_capacity(capacity, item_size) gets the current capacity in items and
+// the item size in bytes, and must return a larger capacity.
+
+// Multiplies the capacity by Num / Den, starting at MinCapacity items.
+template <size_t Num, size_t Den, size_t MinCapacity = 1>
+    requires(Num > Den && Den != 0 && MinCapacity != 0)
+struct GrowFactor {
+    [[nodiscard]] static constexpr size_t
+    next_capacity(size_t capacity, size_t) noexcept {
+        if (capacity < MinCapacity) {
+            return MinCapacity;
+        }
+
+        return std::max(capacity + 1, capacity / Den * Num);
+    }
+};
+
+template <size_t MinCapacity = 1>
+using GrowDouble = GrowFactor<2, 1, MinCapacity>;
+
+template <size_t MinCapacity = 1>
+using GrowOneAndHalf = GrowFactor<3, 2, MinCapacity>;
+
+// Doubles like GrowDouble, but once a block reaches PageSize bytes its size
+// is rounded up to whole pages, so the tail of the last page is usable
+// capacity instead of waste.
+template <size_t PageSize = 4096, size_t MinCapacity = 1>
+    requires(std::has_single_bit(PageSize) && MinCapacity != 0)
+struct GrowPageRounded {
+    [[nodiscard]] static constexpr size_t
+    next_capacity(size_t capacity, size_t item_size) noexcept {
+        const size_t next = GrowDouble<MinCapacity>::next_capacity(
+            capacity, item_size);
+        const size_t bytes = next * item_size;
+
+        if (bytes < PageSize) {
+            return next;
+        }
+
+        return (bytes + PageSize - 1) / PageSize * PageSize / item_size;
+    }
+};
+
+// Doubles, then rounds the block up to the allocator size class it would land
+// in anyway. Classes follow the layout used by jemalloc and tcmalloc: powers
+// of two up to 64 bytes, then four evenly spaced classes per doubling.
+// Capacity that the allocator would have handed out as slack becomes usable.
+template <size_t MinCapacity = 1>
+    requires(MinCapacity != 0)
+struct GrowSizeClass {
+    [[nodiscard]] static constexpr size_t size_class(size_t bytes) noexcept {
+        if (bytes <= 64) {
+            return std::bit_ceil(std::max<size_t>(bytes, 8));
+        }
+
+        const size_t step = std::bit_floor(bytes - 1) / 4;
+        return (bytes + step - 1) / step * step;
+    }
+
+    [[nodiscard]] static constexpr size_t
+    next_capacity(size_t capacity, size_t item_size) noexcept {
+        const size_t next = GrowDouble<MinCapacity>::next_capacity(
+            capacity, item_size);
+
+        return size_class(next * item_size) / item_size;
+    }
+};
+
+namespace internal {
+template <typename Policy>
+concept IsGrowthPolicy = requires(size_t n) {
+    { Policy::next_capacity(n, n) } -> std::same_as<size_t>;
+};
+}
+}
@@ -0,0 +1,785 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "../internal/scope_guard.hpp"
+#include "../internal/type_traits.hpp"
+#include "../macro/assert.hpp"
+#include "growth_policy.hpp"
+
+namespace frank {
+// A DynamicArray that keeps up to N items inside the object itself and only
+// moves them to the heap once it grows past N. The API matches DynamicArray,
+// so the two can be swapped. Unlike DynamicArray it is never null, moving an
+// inline array moves its items one by one, and moving a spilled array steals
+// the heap block.
+template <
+    typename T,
+    size_t N,
+    typename Allocator    = std::allocator<T>,
+    typename GrowthPolicy = GrowDouble<>>
+    requires std::copy_constructible<T> && std::move_constructible<T>
+             && std::destructible<T> && (N != 0)
+             && internal::IsGrowthPolicy<GrowthPolicy>
+class InlineDynamicArray {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+    using growth_policy   = GrowthPolicy;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = std::reverse_iterator<T*>;
+    using const_reverse_iterator = std::reverse_iterator<const T*>;
+    using iterator_category      = std::contiguous_iterator_tag;
+
+    static constexpr size_type inline_capacity = N;
+
+    static_assert(
+        std::is_same_v<typename std::allocator_traits<Allocator>::pointer, T*>,
+        "InlineDynamicArray requires an allocator with raw pointers");
+
+private:
+    // Same layout as DynamicArray::Impl plus the inline buffer. While the
+    // items fit, `first` points at `buffer`; once they spill, the buffer is
+    // unused until the array shrinks back to N items or fewer.
+    struct Impl : public Allocator {
+        pointer first {nullptr};
+        pointer last {nullptr};
+        pointer capacity {nullptr};
+
+        alignas(T) std::byte buffer[N * sizeof(T)];
+
+        ~Impl() noexcept(std::is_nothrow_destructible_v<T>) {
+            destroy_self();
+            deallocate_self();
+        }
+
+        Impl() noexcept(std::is_nothrow_constructible_v<Allocator>)
+            : Allocator() {
+            init_self_inline();
+        }
+
+        Impl(const Allocator& a) noexcept(
+            std::is_nothrow_constructible_v<Allocator, decltype(a)>)
+            : Allocator(a) {
+            init_self_inline();
+        }
+
+        Impl(const Impl& other) = delete;
+        Impl(Impl&& other)      = delete;
+
+        Impl& operator=(const Impl& other) = delete;
+        Impl& operator=(Impl&& other)      = delete;
+
+        [[nodiscard]] pointer inline_first() noexcept {
+            return std::launder(reinterpret_cast<pointer>(buffer));
+        }
+
+        [[nodiscard]] bool is_inline() const noexcept {
+            return static_cast<const void*>(first)
+                   == static_cast<const void*>(buffer);
+        }
+
+        void init_self_inline() noexcept {
+            first    = inline_first();
+            last     = first;
+            capacity = first + N;
+        }
+
+        void deallocate_self() noexcept {
+            if (!is_inline()) {
+                std::allocator_traits<Allocator>::deallocate(
+                    static_cast<Allocator&>(*this),
+                    first,
+                    std::distance(first, capacity));
+            }
+        }
+
+        // Destroys all items, frees the heap block if there is one and goes
+        // back to the inline buffer.
+        void release_self() noexcept(std::is_nothrow_destructible_v<T>) {
+            destroy_self();
+            deallocate_self();
+            init_self_inline();
+        }
+
+        template <typename... Args>
+        void construct_item(pointer p, Args&&... args) noexcept(
+            std::is_nothrow_constructible_v<T, Args...>) {
+            std::allocator_traits<Allocator>::construct(
+                static_cast<Allocator&>(*this), p, std::forward<Args>(args)...);
+        }
+
+        // Constructs `n` items at `dest` from `it`, `it + 1`, ... through the
+        // allocator. Destroys the items already built on failure.
+        template <typename It>
+        void construct_range(It it, size_type n, pointer dest) {
+            pointer p = dest;
+
+            internal::ScopeGuard guard([&]() { destroy_range(dest, p); });
+
+            for (; p != dest + n; ++p, ++it) {
+                construct_item(p, *it);
+            }
+
+            guard.dismiss();
+        }
+
+        void destroy_self() noexcept(std::is_nothrow_destructible_v<T>) {
+            destroy_range(first, last);
+        }
+
+        void destroy_range(pointer a, pointer b) noexcept(
+            std::is_nothrow_destructible_v<T>) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (; a != b; ++a) {
+                    std::allocator_traits<Allocator>::destroy(
+                        static_cast<Allocator&>(*this), a);
+                }
+            }
+        }
+
+        void
+        destroy_item(pointer p) noexcept(std::is_nothrow_destructible_v<T>) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::allocator_traits<Allocator>::destroy(
+                    static_cast<Allocator&>(*this), p);
+            }
+        }
+
+        // Moves [a, b) into uninitialized memory at dest and ends the
+        // lifetime of the source items.
+        void relocate_range(pointer a, pointer b, pointer dest) noexcept(
+            std::is_nothrow_move_constructible_v<T>
+            && std::is_nothrow_destructible_v<T>) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::memcpy(
+                    static_cast<void*>(dest),
+                    static_cast<const void*>(a),
+                    std::distance(a, b) * sizeof(T));
+            } else {
+                std::uninitialized_move(a, b, dest);
+                destroy_range(a, b);
+            }
+        }
+
+        void move_range_right(pointer a, pointer b, size_type n) noexcept(
+            std::is_nothrow_move_assignable_v<T>) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::memmove(
+                    static_cast<void*>(a + n),
+                    static_cast<const void*>(a),
+                    std::distance(a, b) * sizeof(T));
+            } else {
+                std::move_backward(a, b, b + n);
+            }
+        }
+
+        void move_range_left(pointer a, pointer b, size_type n) noexcept(
+            std::is_nothrow_move_assignable_v<T>) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::memmove(
+                    static_cast<void*>(a - n),
+                    static_cast<const void*>(a),
+                    std::distance(a, b) * sizeof(T));
+            } else {
+                std::move(a, b, a - n);
+            }
+        }
+
+        // Moves every item into the block [p, p + cap) and releases the old
+        // storage.
+        void move_self_to(pointer p, size_type cap) noexcept(
+            std::is_nothrow_move_constructible_v<T>
+            && std::is_nothrow_destructible_v<T>) {
+            const size_type n = std::distance(first, last);
+
+            relocate_range(first, last, p);
+            last = first;
+            deallocate_self();
+
+            first    = p;
+            last     = p + n;
+            capacity = p + cap;
+        }
+
+        // Moves the items into a new heap block of `cap`. The block is freed
+        // again if moving an item throws.
+        void move_self_to_heap(size_type cap) {
+            pointer p = std::allocator_traits<Allocator>::allocate(
+                static_cast<Allocator&>(*this), cap);
+
+            internal::ScopeGuard guard([&]() {
+                std::allocator_traits<Allocator>::deallocate(
+                    static_cast<Allocator&>(*this), p, cap);
+            });
+
+            move_self_to(p, cap);
+
+            guard.dismiss();
+        }
+
+        inline void advance(size_type n) {
+            FRANK_ASSERT(n != 0);
+            std::advance(last, n);
+        }
+
+        inline void prev(size_type n) {
+            FRANK_ASSERT(n != 0);
+            last = std::prev(last, n);
+        }
+    };
+
+    Impl impl;
+
+public:
+    ~InlineDynamicArray() = default;
+
+    InlineDynamicArray() noexcept(std::is_nothrow_constructible_v<Impl>)
+        : impl() { }
+
+    explicit InlineDynamicArray(const Allocator& a) noexcept(
+        std::is_nothrow_constructible_v<Impl, decltype(a)>)
+        : impl(a) { }
+
+    explicit InlineDynamicArray(
+        size_type sz, const Allocator& a = Allocator())
+        : impl(a) {
+        if (sz > capacity()) {
+            grow(sz);
+        }
+    }
+
+    InlineDynamicArray(const InlineDynamicArray& other)
+        : InlineDynamicArray(
+              other,
+              std::allocator_traits<Allocator>::
+                  select_on_container_copy_construction(
+                      static_cast<const Allocator&>(other.impl))) { }
+
+    InlineDynamicArray(const InlineDynamicArray& other, const Allocator& a)
+        : impl(a) {
+        assign(other.cbegin(), other.cend());
+    }
+
+    // The allocator is copied, not moved, so it still compares equal to that
+    // of `other` and a spilled block is always stolen without allocating.
+    InlineDynamicArray(InlineDynamicArray&& other) noexcept(
+        std::is_nothrow_copy_constructible_v<Allocator>
+        && std::is_nothrow_move_constructible_v<T>)
+        : impl(static_cast<const Allocator&>(other.impl)) {
+        take(other);
+    }
+
+    InlineDynamicArray(
+        std::initializer_list<T> il, const Allocator& a = Allocator())
+        : impl(a) {
+        assign(il);
+    }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    InlineDynamicArray(It a, It b) {
+        assign(a, b);
+    }
+
+    InlineDynamicArray& operator=(const InlineDynamicArray& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_copy_assignment::value) {
+            if (static_cast<const Allocator&>(impl)
+                != static_cast<const Allocator&>(other.impl)) {
+                impl.release_self();
+            }
+
+            static_cast<Allocator&>(impl)
+                = static_cast<const Allocator&>(other.impl);
+        }
+
+        assign(other.cbegin(), other.cend());
+        return *this;
+    }
+
+    InlineDynamicArray& operator=(InlineDynamicArray&& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        impl.release_self();
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_move_assignment::value) {
+            static_cast<Allocator&>(impl)
+                = std::move(static_cast<Allocator&>(other.impl));
+        }
+
+        take(other);
+        return *this;
+    }
+
+    bool operator==(const InlineDynamicArray& other) const noexcept {
+        return size() == other.size()
+               && std::equal(cbegin(), cend(), other.cbegin());
+    }
+
+    auto operator<=>(const InlineDynamicArray& other) const
+        requires std::three_way_comparable<T>
+    {
+        return std::lexicographical_compare_three_way(
+            cbegin(),
+            cend(),
+            other.cbegin(),
+            other.cend(),
+            std::compare_three_way {});
+    }
+
+public:
+    iterator       begin() noexcept { return impl.first; }
+    const_iterator begin() const noexcept { return impl.first; }
+
+    iterator       end() noexcept { return impl.last; }
+    const_iterator end() const noexcept { return impl.last; }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return impl.first; }
+    const_iterator cend() const noexcept { return impl.last; }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    reference operator[](size_type idx) noexcept { return impl.first[idx]; }
+    const_reference operator[](size_type idx) const noexcept {
+        return impl.first[idx];
+    }
+
+    [[nodiscard]] std::optional<reference> at(size_type idx) noexcept {
+        return is_idx_valid(idx) ? std::optional<reference>(impl.first[idx]) :
+                                   std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<const_reference>
+    at(size_type idx) const noexcept {
+        return is_idx_valid(idx) ?
+                   std::optional<const_reference>(impl.first[idx]) :
+                   std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<reference> front() noexcept {
+        return is_empty() ? std::nullopt :
+                            std::optional<reference>(*impl.first);
+    }
+
+    [[nodiscard]] std::optional<const_reference> front() const noexcept {
+        return is_empty() ? std::nullopt :
+                            std::optional<const_reference>(*impl.first);
+    }
+
+    reference front_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *impl.first;
+    }
+    const_reference front_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *impl.first;
+    }
+
+    [[nodiscard]] std::optional<reference> back() noexcept {
+        return is_empty() ? std::nullopt :
+                            std::optional<reference>(impl.last[-1]);
+    }
+
+    [[nodiscard]] std::optional<const_reference> back() const noexcept {
+        return is_empty() ? std::nullopt :
+                            std::optional<const_reference>(impl.last[-1]);
+    }
+
+    reference back_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return impl.last[-1];
+    }
+    const_reference back_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return impl.last[-1];
+    }
+
+    // Always false, the inline buffer is storage too. Kept for parity with
+    // DynamicArray.
+    [[nodiscard]] bool is_null() const noexcept { return false; }
+
+    [[nodiscard]] bool is_inline() const noexcept { return impl.is_inline(); }
+
+    [[nodiscard]] bool is_empty() const noexcept {
+        return impl.first == impl.last;
+    }
+
+    [[nodiscard]] bool is_full() const noexcept {
+        return impl.last == impl.capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return std::distance(impl.first, impl.last);
+    }
+
+    [[nodiscard]] size_type capacity() const noexcept {
+        return std::distance(impl.first, impl.capacity);
+    }
+
+    [[nodiscard]] constexpr size_type max_size() const noexcept {
+        return std::allocator_traits<Allocator>::max_size(
+            static_cast<const Allocator&>(impl));
+    }
+
+    [[nodiscard]] Allocator allocator() const noexcept {
+        return static_cast<Allocator>(impl);
+    }
+
+    T*       data() noexcept { return impl.first; }
+    const T* data() const noexcept { return impl.first; }
+
+public:
+    void push_back(const T& item) { emplace_back(item); }
+
+    void push_back(T&& item) { emplace_back(std::move(item)); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        if (is_full()) {
+            grow(calc_next_capacity());
+        }
+
+        impl.construct_item(impl.last, std::forward<Args>(args)...);
+        impl.advance(1);
+    }
+
+    void pop_back() noexcept(std::is_nothrow_destructible_v<T>) {
+        FRANK_ASSERT(!is_empty());
+
+        impl.prev(1);
+        impl.destroy_item(impl.last);
+    }
+
+    void insert(size_type idx, const T& item) { emplace(idx, item); }
+
+    void insert(size_type idx, T&& item) { emplace(idx, std::move(item)); }
+
+    template <typename... Args>
+    void emplace(size_type idx, Args&&... args) {
+        FRANK_ASSERT(idx <= size());
+
+        if (idx == size()) {
+            emplace_back(std::forward<Args>(args)...);
+            return;
+        }
+
+        // Built up front, args may refer to items that are about to move.
+        T item(std::forward<Args>(args)...);
+
+        if (is_full()) {
+            grow(calc_next_capacity());
+        }
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            impl.move_range_right(impl.first + idx, impl.last, 1);
+            impl.construct_item(impl.first + idx, std::move(item));
+        } else {
+            impl.construct_item(impl.last, std::move(impl.last[-1]));
+            impl.move_range_right(impl.first + idx, impl.last - 1, 1);
+            impl.first[idx] = std::move(item);
+        }
+
+        impl.advance(1);
+    }
+
+    // Appends every item of `r`. Sized and forward ranges reserve once for
+    // the whole batch; contiguous ranges of trivially copyable items are
+    // copied with a single memcpy. `r` must not refer to items of this array,
+    // reserving may move them before they are copied.
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void append_range(R&& r) {
+        if constexpr (
+            std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+            const size_type n
+                = static_cast<size_type>(std::ranges::distance(r));
+
+            if (n == 0) {
+                return;
+            }
+
+            reserve_for(n);
+
+            if constexpr (
+                std::ranges::contiguous_range<R>
+                && std::is_trivially_copyable_v<T>
+                && std::is_same_v<std::ranges::range_value_t<R>, T>) {
+                std::memcpy(
+                    static_cast<void*>(impl.last),
+                    static_cast<const void*>(std::ranges::data(r)),
+                    n * sizeof(T));
+            } else {
+                impl.construct_range(std::ranges::begin(r), n, impl.last);
+            }
+
+            impl.advance(n);
+        } else {
+            for (auto&& item : r) {
+                emplace_back(std::forward<decltype(item)>(item));
+            }
+        }
+    }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    void append(It a, It b) {
+        append_range(std::ranges::subrange(a, b));
+    }
+
+    // Inserts every item of `r` before `idx`, reserving once. `r` must not
+    // refer to items of this array.
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void insert_range(size_type idx, R&& r) {
+        FRANK_ASSERT(idx <= size());
+
+        if constexpr (
+            std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+            && std::is_trivially_copyable_v<T>
+            && std::is_same_v<std::ranges::range_value_t<R>, T>) {
+            const size_type n = std::ranges::size(r);
+
+            if (n == 0) {
+                return;
+            }
+
+            reserve_for(n);
+
+            impl.move_range_right(impl.first + idx, impl.last, n);
+            std::memcpy(
+                static_cast<void*>(impl.first + idx),
+                static_cast<const void*>(std::ranges::data(r)),
+                n * sizeof(T));
+            impl.advance(n);
+        } else {
+            // Append, then rotate the new items into place. Works for any
+            // range, including single pass ones, and only needs moves.
+            const size_type old_size = size();
+
+            append_range(std::forward<R>(r));
+            std::rotate(impl.first + idx, impl.first + old_size, impl.last);
+        }
+    }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    void insert(size_type idx, It a, It b) {
+        insert_range(idx, std::ranges::subrange(a, b));
+    }
+
+    void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    void assign(It a, It b) {
+        clear();
+
+        size_type size = std::distance(a, b);
+        if (size > capacity()) {
+            grow(size);
+        }
+
+        if constexpr (
+            std::contiguous_iterator<It> && std::is_trivially_copyable_v<T>
+            && std::is_same_v<std::iter_value_t<It>, T>) {
+            if (size != 0) {
+                std::memcpy(
+                    static_cast<void*>(impl.first),
+                    static_cast<const void*>(std::to_address(a)),
+                    size * sizeof(T));
+            }
+        } else {
+            impl.construct_range(a, size, impl.first);
+        }
+
+        if (size != 0) {
+            impl.advance(size);
+        }
+    }
+
+    void erase(size_type idx) noexcept(
+        std::is_nothrow_destructible_v<T>
+        && std::is_nothrow_move_assignable_v<T>) {
+        FRANK_ASSERT(is_idx_valid(idx));
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            impl.destroy_item(impl.first + idx);
+            impl.move_range_left(impl.first + idx + 1, impl.last, 1);
+            impl.prev(1);
+        } else {
+            impl.move_range_left(impl.first + idx + 1, impl.last, 1);
+            pop_back();
+        }
+    }
+
+    void clear() noexcept(std::is_nothrow_destructible_v<T>) {
+        impl.destroy_self();
+        impl.last = impl.first;
+    }
+
+    // Changes the size to `sz` without value initializing new items. Items of
+    // trivially default constructible types are left indeterminate, so the
+    // caller must overwrite them (with read(), memcpy, a decoder, ...) before
+    // reading them. Other types are default constructed.
+    void resize_for_overwrite(size_type sz)
+        requires std::default_initializable<T>
+    {
+        if (sz <= size()) {
+            impl.destroy_range(impl.first + sz, impl.last);
+            impl.last = impl.first + sz;
+            return;
+        }
+
+        reserve_for(sz - size());
+
+        if constexpr (std::is_trivially_default_constructible_v<T>) {
+            impl.advance(sz - size());
+        } else {
+            while (size() < sz) {
+                impl.construct_item(impl.last);
+                impl.advance(1);
+            }
+        }
+    }
+
+    void reserve(size_type sz) {
+        FRANK_ASSERT(sz > size());
+
+        if (sz <= capacity()) {
+            return;
+        }
+
+        grow(sz);
+    }
+
+    void grow(size_type sz) {
+        FRANK_ASSERT(sz > capacity());
+        impl.move_self_to_heap(sz);
+    }
+
+    void shrink_to_fit() {
+        if (size() < capacity()) {
+            shrink(size());
+        }
+    }
+
+    // Shrinks the heap block to `sz` items, or moves the items back inline if
+    // `sz` fits into the inline buffer. Does nothing while already inline.
+    void shrink(size_type sz) {
+        FRANK_ASSERT(sz < capacity());
+        FRANK_ASSERT(sz >= size());
+
+        if (impl.is_inline()) {
+            return;
+        }
+
+        if (sz <= N) {
+            impl.move_self_to(impl.inline_first(), N);
+            return;
+        }
+
+        impl.move_self_to_heap(sz);
+    }
+
+private:
+    // Takes the items of `other`, which must be empty-handed afterwards. A
+    // heap block is stolen when the allocators allow it; inline items are
+    // relocated one by one.
+    void take(InlineDynamicArray& other) {
+        FRANK_ASSERT(is_empty() && impl.is_inline());
+
+        if (!other.impl.is_inline()
+            && static_cast<const Allocator&>(impl)
+                   == static_cast<const Allocator&>(other.impl)) {
+            impl.first    = other.impl.first;
+            impl.last     = other.impl.last;
+            impl.capacity = other.impl.capacity;
+
+            other.impl.init_self_inline();
+            return;
+        }
+
+        if (other.size() > capacity()) {
+            grow(other.size());
+        }
+
+        const size_type n = other.size();
+
+        other.impl.relocate_range(
+            other.impl.first, other.impl.last, impl.first);
+        other.impl.last = other.impl.first;
+
+        if (n != 0) {
+            impl.advance(n);
+        }
+    }
+
+    [[nodiscard]] inline bool is_idx_valid(size_type idx) const noexcept {
+        return idx < size();
+    }
+
+    [[nodiscard]] inline size_type calc_next_capacity() const noexcept {
+        return GrowthPolicy::next_capacity(capacity(), sizeof(T));
+    }
+
+    // Makes room for `n` more items with at most one reallocation, without
+    // giving up the geometric growth of the policy.
+    void reserve_for(size_type n) {
+        if (size() + n > capacity()) {
+            grow(std::max(size() + n, calc_next_capacity()));
+        }
+    }
+};
+}
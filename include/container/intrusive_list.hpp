@@ -0,0 +1,347 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "../macro/assert.hpp"
+
+namespace frank {
+// The links of an IntrusiveList, embedded in the object being listed. An
+// object can sit on several lists at once by having one hook per list.
+//
+// A linked hook unlinks itself when it is destroyed, so an object never
+// leaves a dangling pointer behind on the list it was on. Copying an object
+// does not copy its list memberships.
+class IntrusiveListHook {
+private:
+    template <typename T, IntrusiveListHook T::*Hook>
+    friend class IntrusiveList;
+
+    IntrusiveListHook* m_prev {nullptr};
+    IntrusiveListHook* m_next {nullptr};
+
+public:
+    ~IntrusiveListHook() noexcept { unlink(); }
+
+    IntrusiveListHook() noexcept = default;
+
+    IntrusiveListHook(const IntrusiveListHook&) noexcept { }
+
+    IntrusiveListHook& operator=(const IntrusiveListHook&) noexcept {
+        return *this;
+    }
+
+public:
+    [[nodiscard]] bool is_linked() const noexcept { return m_next != nullptr; }
+
+    // Removes the owner from whatever list it is on. O(1), does nothing if
+    // the hook is not linked.
+    void unlink() noexcept {
+        if (!is_linked()) {
+            return;
+        }
+
+        m_prev->m_next = m_next;
+        m_next->m_prev = m_prev;
+        m_prev         = nullptr;
+        m_next         = nullptr;
+    }
+
+private:
+    void link_before(IntrusiveListHook* next) noexcept {
+        FRANK_ASSERT(!is_linked());
+
+        m_prev         = next->m_prev;
+        m_next         = next;
+        m_prev->m_next = this;
+        next->m_prev   = this;
+    }
+};
+
+// A doubly linked list of objects that carry their own links in the member
+// `Hook`. The list never allocates and never owns its items: pushing links
+// the object in place, popping or erasing only unlinks it, and the caller
+// keeps the objects alive for as long as they are linked.
+//
+// Internally the list is circular around a sentinel hook, which makes
+// unlinking branch free and lets an object leave the list through its hook
+// alone. For the same reason the list does not keep a size.
+template <typename T, IntrusiveListHook T::*Hook>
+class IntrusiveList {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+private:
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class IntrusiveList;
+
+        using Link = std::
+            conditional_t<Const, const IntrusiveListHook, IntrusiveListHook>;
+
+        Link* m_link {nullptr};
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() noexcept = default;
+
+        explicit Iterator(Link* link) noexcept
+            : m_link(link) { }
+
+        operator Iterator<true>() const noexcept
+            requires(!Const)
+        {
+            return Iterator<true>(m_link);
+        }
+
+        reference operator*() const noexcept { return *owner_of(m_link); }
+        pointer   operator->() const noexcept { return owner_of(m_link); }
+
+        Iterator& operator++() noexcept {
+            m_link = m_link->m_next;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            m_link       = m_link->m_next;
+            return old;
+        }
+
+        Iterator& operator--() noexcept {
+            m_link = m_link->m_prev;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            m_link       = m_link->m_prev;
+            return old;
+        }
+
+        friend bool
+        operator==(const Iterator& a, const Iterator& b) noexcept {
+            return a.m_link == b.m_link;
+        }
+    };
+
+public:
+    using iterator               = Iterator<false>;
+    using const_iterator         = Iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using iterator_category      = std::bidirectional_iterator_tag;
+
+private:
+    IntrusiveListHook m_root;
+
+    // Offset of the hook inside T. It can only be taken on a live object, so
+    // link() measures it on the first item ever linked; every item that
+    // owner_of() sees was linked after that.
+    static inline std::ptrdiff_t s_hook_offset {0};
+
+public:
+    ~IntrusiveList() noexcept { clear(); }
+
+    IntrusiveList() noexcept { reset_root(); }
+
+    IntrusiveList(const IntrusiveList&) = delete;
+
+    IntrusiveList(IntrusiveList&& other) noexcept {
+        reset_root();
+        splice(end(), other);
+    }
+
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            splice(end(), other);
+        }
+
+        return *this;
+    }
+
+public:
+    iterator       begin() noexcept { return iterator(m_root.m_next); }
+    const_iterator begin() const noexcept {
+        return const_iterator(m_root.m_next);
+    }
+
+    iterator       end() noexcept { return iterator(&m_root); }
+    const_iterator end() const noexcept { return const_iterator(&m_root); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    reference front_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *owner_of(m_root.m_next);
+    }
+    const_reference front_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *owner_of(m_root.m_next);
+    }
+
+    reference back_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *owner_of(m_root.m_prev);
+    }
+    const_reference back_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *owner_of(m_root.m_prev);
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept {
+        return m_root.m_next == &m_root;
+    }
+
+    // Returns an iterator to `item`, which must be linked into this list.
+    [[nodiscard]] iterator iterator_to(T& item) noexcept {
+        FRANK_ASSERT((item.*Hook).is_linked());
+        return iterator(&(item.*Hook));
+    }
+
+public:
+    void push_back(T& item) noexcept { link(item, &m_root); }
+
+    void push_front(T& item) noexcept { link(item, m_root.m_next); }
+
+    // Links `item` before `pos` and returns an iterator to it.
+    iterator insert(const_iterator pos, T& item) noexcept {
+        link(item, mutable_link(pos));
+        return iterator(&(item.*Hook));
+    }
+
+    reference pop_front() noexcept {
+        FRANK_ASSERT(!is_empty());
+
+        T& item = *owner_of(m_root.m_next);
+        (item.*Hook).unlink();
+
+        return item;
+    }
+
+    reference pop_back() noexcept {
+        FRANK_ASSERT(!is_empty());
+
+        T& item = *owner_of(m_root.m_prev);
+        (item.*Hook).unlink();
+
+        return item;
+    }
+
+    // Unlinks the item at `pos` and returns an iterator to the one after it.
+    iterator erase(const_iterator pos) noexcept {
+        FRANK_ASSERT(pos != end());
+
+        IntrusiveListHook* link = mutable_link(pos);
+        IntrusiveListHook* next = link->m_next;
+        link->unlink();
+
+        return iterator(next);
+    }
+
+    // Moves every item of `other` before `pos`. O(1), nothing is copied.
+    void splice(const_iterator pos, IntrusiveList& other) noexcept {
+        splice(pos, other, other.begin(), other.end());
+    }
+
+    // Moves [a, b) of `other` before `pos`. O(1), nothing is copied.
+    void splice(
+        const_iterator pos,
+        IntrusiveList&,
+        const_iterator a,
+        const_iterator b) noexcept {
+        if (a == b) {
+            return;
+        }
+
+        IntrusiveListHook* next  = mutable_link(pos);
+        IntrusiveListHook* first = mutable_link(a);
+        IntrusiveListHook* last  = mutable_link(b)->m_prev;
+
+        first->m_prev->m_next = last->m_next;
+        last->m_next->m_prev  = first->m_prev;
+
+        first->m_prev        = next->m_prev;
+        last->m_next         = next;
+        next->m_prev->m_next = first;
+        next->m_prev         = last;
+    }
+
+    // Unlinks every item. The items themselves are left alone.
+    void clear() noexcept {
+        IntrusiveListHook* link = m_root.m_next;
+
+        while (link != &m_root) {
+            IntrusiveListHook* next = link->m_next;
+            link->m_prev            = nullptr;
+            link->m_next            = nullptr;
+            link                    = next;
+        }
+
+        reset_root();
+    }
+
+private:
+    void reset_root() noexcept {
+        m_root.m_prev = &m_root;
+        m_root.m_next = &m_root;
+    }
+
+    [[nodiscard]] static IntrusiveListHook*
+    mutable_link(const_iterator it) noexcept {
+        return const_cast<IntrusiveListHook*>(it.m_link);
+    }
+
+    static void link(T& item, IntrusiveListHook* next) noexcept {
+        [[maybe_unused]] static const bool measured = [&]() {
+            s_hook_offset = reinterpret_cast<std::byte*>(&(item.*Hook))
+                            - reinterpret_cast<std::byte*>(&item);
+            return true;
+        }();
+
+        (item.*Hook).link_before(next);
+    }
+
+    [[nodiscard]] static T* owner_of(IntrusiveListHook* link) noexcept {
+        return reinterpret_cast<T*>(
+            reinterpret_cast<std::byte*>(link) - s_hook_offset);
+    }
+
+    [[nodiscard]] static const T*
+    owner_of(const IntrusiveListHook* link) noexcept {
+        return reinterpret_cast<const T*>(
+            reinterpret_cast<const std::byte*>(link) - s_hook_offset);
+    }
+};
+}
@@ -2,19 +2,40 @@
 // Licensed under the MIT License.
 // See LICENSE.md file in the project root for full license information.
 
+#pragma once
+
 #include "../internal/scope_guard.hpp"
 #include "../macro/assert.hpp"
+#include "../memory/pool_allocator.hpp"
+#include <concepts>
+#include <cstddef>
 #include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
+#include <utility>
 
 namespace frank {
+namespace internal {
+template <typename Allocator>
+inline constexpr bool is_polymorphic_allocator_v = false;
+
+template <typename T>
+inline constexpr bool
+    is_polymorphic_allocator_v<std::pmr::polymorphic_allocator<T>>
+    = true;
+}
+
+// The links of a ListNode. A List keeps one of these as the end sentinel,
+// so every iterator, end() included, is just a node pointer.
+struct ListNodeBase {
+    ListNodeBase* prev {nullptr};
+    ListNodeBase* next {nullptr};
+};
 
 template <typename T>
-struct ListNode {
-    ListNode* prev {nullptr};
-    ListNode* next {nullptr};
-    T         item;
+struct ListNode : public ListNodeBase {
+    T item;
 
     ~ListNode() = default;
     ListNode()  = delete;
@@ -24,6 +45,13 @@ struct ListNode {
         std::is_nothrow_constructible_v<T, Args&&...>)
         : item(std::forward<Args>(args)...) { }
 
+    // Uses-allocator construction of the item, so an item that takes an
+    // allocator (std::pmr::string) ends up on the same resource as the list.
+    template <typename Alloc, typename... Args>
+    ListNode(std::allocator_arg_t, const Alloc& a, Args&&... args)
+        : item(std::make_obj_using_allocator<T>(
+              a, std::forward<Args>(args)...)) { }
+
     ListNode(const ListNode&) = delete;
     ListNode(ListNode&&)      = delete;
 
@@ -31,6 +59,14 @@ struct ListNode {
     ListNode& operator=(ListNode&&)      = delete;
 };
 
+// A doubly linked list with one heap node per item, circular around a
+// sentinel held by the list. Nodes never move, so iterators and references
+// stay valid until their item is erased, also across splice().
+//
+// splice() hands nodes over to another list without touching the items,
+// which is O(1) for whole lists and ranges alike. The price is that the list
+// does not track its size. Splicing requires equal allocators, since the
+// receiving list ends up freeing the nodes.
 template <typename T, typename Allocator = std::allocator<ListNode<T>>>
 class List {
 private:
@@ -46,34 +82,104 @@ public:
     using pointer         = std::allocator_traits<Allocator>::pointer;
     using const_pointer   = std::allocator_traits<Allocator>::const_pointer;
 
-    using iterator               = Node*;
-    using const_iterator         = const Node*;
-    using reverse_iterator       = std::reverse_iterator<Node*>;
-    using const_reverse_iterator = std::reverse_iterator<const Node*>;
+private:
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class List;
+
+        ListNodeBase* m_node {nullptr};
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() noexcept = default;
+
+        explicit Iterator(ListNodeBase* node) noexcept
+            : m_node(node) { }
+
+        operator Iterator<true>() const noexcept
+            requires(!Const)
+        {
+            return Iterator<true>(m_node);
+        }
+
+        reference operator*() const noexcept {
+            return static_cast<Node*>(m_node)->item;
+        }
+        pointer operator->() const noexcept {
+            return &static_cast<Node*>(m_node)->item;
+        }
+
+        Iterator& operator++() noexcept {
+            m_node = m_node->next;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            m_node       = m_node->next;
+            return old;
+        }
+
+        // Decrementing end() lands on the last item.
+        Iterator& operator--() noexcept {
+            m_node = m_node->prev;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        friend bool
+        operator==(const Iterator& a, const Iterator& b) noexcept {
+            return a.m_node == b.m_node;
+        }
+    };
+
+public:
+    using iterator               = Iterator<false>;
+    using const_iterator         = Iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     using iterator_category      = std::bidirectional_iterator_tag;
 
 private:
     struct Impl : public Allocator {
-        Node* head {nullptr};
-        Node* tail {nullptr};
+        // sentinel.next is the head and sentinel.prev the tail. An empty list
+        // links the sentinel to itself.
+        ListNodeBase sentinel;
 
         ~Impl() noexcept(std::is_nothrow_destructible_v<T>) {
-            while (head != nullptr) {
-                Node* next = head->next;
-
-                destroy_node(head);
-                deallocate_node(head);
-
-                head = next;
+            // Pools nobody else refers to are released right after this,
+            // blocks and all, so trivial items need no walk over the nodes.
+            if constexpr (internal::is_pool_allocator_v<Allocator>
+                          && std::is_trivially_destructible_v<T>) {
+                if (static_cast<const Allocator&>(*this).is_sole_owner()) {
+                    return;
+                }
             }
+
+            destroy_self();
         }
 
         Impl(const Allocator& a) noexcept(
             std::is_nothrow_constructible_v<Allocator, decltype(a)>)
-            : Allocator(a) { }
+            : Allocator(a) {
+            init_self_empty();
+        }
 
         Impl()
-            : Allocator() { };
+            : Allocator() {
+            init_self_empty();
+        };
 
         Impl(const Impl&) = delete;
         Impl(Impl&&)      = delete;
@@ -81,7 +187,26 @@ private:
         Impl& operator=(const Impl&) = delete;
         Impl& operator=(Impl&&)      = delete;
 
-        [[nodiscard]] inline bool is_null() noexcept { return head == nullptr; }
+        [[nodiscard]] inline bool is_null() const noexcept {
+            return sentinel.next == &sentinel;
+        }
+
+        [[nodiscard]] ListNodeBase* end_node() const noexcept {
+            return const_cast<ListNodeBase*>(&sentinel);
+        }
+
+        [[nodiscard]] Node* head() const noexcept {
+            return static_cast<Node*>(sentinel.next);
+        }
+
+        [[nodiscard]] Node* tail() const noexcept {
+            return static_cast<Node*>(sentinel.prev);
+        }
+
+        void init_self_empty() noexcept {
+            sentinel.prev = &sentinel;
+            sentinel.next = &sentinel;
+        }
 
         [[nodiscard]] Node* allocate_node() {
             Node* node = std::allocator_traits<Allocator>::allocate(
@@ -125,6 +250,59 @@ private:
             std::allocator_traits<Allocator>::deallocate(
                 static_cast<Allocator&>(*this), node, 1);
         }
+
+        void destroy_self() noexcept(std::is_nothrow_destructible_v<T>) {
+            ListNodeBase* it = sentinel.next;
+
+            while (it != &sentinel) {
+                ListNodeBase* next = it->next;
+
+                destroy_node(static_cast<Node*>(it));
+                deallocate_node(static_cast<Node*>(it));
+
+                it = next;
+            }
+
+            init_self_empty();
+        }
+
+        // Links the chain [first, last] in front of `next`, which may be the
+        // sentinel.
+        static void link_before(
+            ListNodeBase* first,
+            ListNodeBase* last,
+            ListNodeBase* next) noexcept {
+            ListNodeBase* prev = next->prev;
+
+            first->prev = prev;
+            last->next  = next;
+            prev->next  = first;
+            next->prev  = last;
+        }
+
+        // Detaches the chain [first, last]. The chain keeps its inner links.
+        static void unlink(ListNodeBase* first, ListNodeBase* last) noexcept {
+            first->prev->next = last->next;
+            last->next->prev  = first->prev;
+
+            first->prev = nullptr;
+            last->next  = nullptr;
+        }
+
+        // Takes the nodes of `other`. Must be empty.
+        void steal(Impl& other) noexcept {
+            FRANK_ASSERT(is_null());
+
+            if (other.is_null()) {
+                return;
+            }
+
+            ListNodeBase* first = other.sentinel.next;
+            ListNodeBase* last  = other.sentinel.prev;
+
+            other.init_self_empty();
+            link_before(first, last, &sentinel);
+        }
     };
 
     Impl impl;
@@ -134,35 +312,270 @@ public:
 
     List() { }
 
+    explicit List(const Allocator& a) noexcept(
+        std::is_nothrow_constructible_v<Impl, decltype(a)>)
+        : impl(a) { }
+
+    List(const List& other)
+        requires std::copy_constructible<T>
+        : List(
+              other,
+              std::allocator_traits<Allocator>::
+                  select_on_container_copy_construction(
+                      static_cast<const Allocator&>(other.impl))) { }
+
+    List(const List& other, const Allocator& a)
+        requires std::copy_constructible<T>
+        : impl(a) {
+        for (const T& item : other) {
+            emplace_back(item);
+        }
+    }
+
+    // The allocator is copied rather than moved so `other` stays usable.
+    List(List&& other) noexcept
+        : impl(static_cast<const Allocator&>(other.impl)) {
+        impl.steal(other.impl);
+    }
+
+    List& operator=(const List& other)
+        requires std::copy_constructible<T>
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_copy_assignment::value) {
+            List copy(other, static_cast<const Allocator&>(other.impl));
+            impl.destroy_self();
+            static_cast<Allocator&>(impl) = static_cast<Allocator&>(copy.impl);
+            impl.steal(copy.impl);
+        } else {
+            List copy(other, static_cast<const Allocator&>(impl));
+            impl.destroy_self();
+            impl.steal(copy.impl);
+        }
+
+        return *this;
+    }
+
+    // Without propagation the allocator stays put (std::pmr), and if it
+    // differs from that of `other` the items are moved over one by one.
+    List& operator=(List&& other) noexcept(
+        std::is_nothrow_destructible_v<T>
+        && (std::allocator_traits<
+                Allocator>::propagate_on_container_move_assignment::value
+            || std::allocator_traits<Allocator>::is_always_equal::value)) {
+        if (this == &other) {
+            return *this;
+        }
+
+        impl.destroy_self();
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_move_assignment::value) {
+            static_cast<Allocator&>(impl)
+                = static_cast<Allocator&>(other.impl);
+        } else if (static_cast<Allocator&>(impl)
+                   != static_cast<Allocator&>(other.impl)) {
+            for (T& item : other) {
+                emplace_back(std::move(item));
+            }
+
+            other.clear();
+            return *this;
+        }
+
+        impl.steal(other.impl);
+
+        return *this;
+    }
+
 public:
+    iterator       begin() noexcept { return iterator(impl.sentinel.next); }
+    const_iterator begin() const noexcept {
+        return const_iterator(impl.sentinel.next);
+    }
+
+    iterator       end() noexcept { return iterator(impl.end_node()); }
+    const_iterator end() const noexcept {
+        return const_iterator(impl.end_node());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
     reference head() noexcept {
         FRANK_ASSERT(!is_null());
-        return impl.head->item;
+        return impl.head()->item;
+    }
+
+    reference front_unsafe() noexcept {
+        FRANK_ASSERT(!is_null());
+        return impl.head()->item;
+    }
+    const_reference front_unsafe() const noexcept {
+        FRANK_ASSERT(!is_null());
+        return impl.head()->item;
+    }
+
+    reference back_unsafe() noexcept {
+        FRANK_ASSERT(!is_null());
+        return impl.tail()->item;
+    }
+    const_reference back_unsafe() const noexcept {
+        FRANK_ASSERT(!is_null());
+        return impl.tail()->item;
     }
 
 public:
-    [[nodiscard]] bool is_null() { return impl.is_null(); }
+    [[nodiscard]] bool is_null() const noexcept { return impl.is_null(); }
+
+    [[nodiscard]] bool is_empty() const noexcept { return impl.is_null(); }
+
+    [[nodiscard]] Allocator allocator() const noexcept {
+        return static_cast<Allocator>(impl);
+    }
 
 public:
-    iterator push_back(const T& item) noexcept { return emplace_back(item); }
+    iterator push_back(const T& item) { return emplace_back(item); }
+
+    iterator push_back(T&& item) { return emplace_back(std::move(item)); }
+
+    iterator push_front(const T& item) { return emplace_front(item); }
+
+    iterator push_front(T&& item) { return emplace_front(std::move(item)); }
 
     template <typename... Args>
     iterator emplace_back(Args&&... args) {
+        return emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator emplace_front(Args&&... args) {
+        return emplace(cbegin(), std::forward<Args>(args)...);
+    }
+
+    iterator insert(const_iterator pos, const T& item) {
+        return emplace(pos, item);
+    }
+
+    iterator insert(const_iterator pos, T&& item) {
+        return emplace(pos, std::move(item));
+    }
+
+    // Constructs an item before `pos` and returns an iterator to it.
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
         Node* node = impl.allocate_node();
-        impl.construct_node(node, std::forward<Args>(args)...);
 
-        if (is_null()) {
-            impl.head = node;
-            impl.tail = node;
+        if constexpr (internal::is_polymorphic_allocator_v<Allocator>) {
+            impl.construct_node(
+                node,
+                std::allocator_arg,
+                static_cast<const Allocator&>(impl),
+                std::forward<Args>(args)...);
+        } else {
+            impl.construct_node(node, std::forward<Args>(args)...);
+        }
 
-            return node;
+        impl.link_before(node, node, pos.m_node);
+
+        return iterator(node);
+    }
+
+    void pop_front() noexcept(std::is_nothrow_destructible_v<T>) {
+        FRANK_ASSERT(!is_null());
+        erase(cbegin());
+    }
+
+    void pop_back() noexcept(std::is_nothrow_destructible_v<T>) {
+        FRANK_ASSERT(!is_null());
+        erase(const_iterator(impl.sentinel.prev));
+    }
+
+    // Erases the item at `pos` and returns an iterator to the one after it.
+    iterator erase(const_iterator pos) noexcept(
+        std::is_nothrow_destructible_v<T>) {
+        FRANK_ASSERT(pos.m_node != &impl.sentinel);
+
+        Node*         node = static_cast<Node*>(pos.m_node);
+        ListNodeBase* next = node->next;
+
+        impl.unlink(node, node);
+        impl.destroy_node(node);
+        impl.deallocate_node(node);
+
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator a, const_iterator b) noexcept(
+        std::is_nothrow_destructible_v<T>) {
+        while (a != b) {
+            a = erase(a);
+        }
+
+        return iterator(b.m_node);
+    }
+
+    void clear() noexcept(std::is_nothrow_destructible_v<T>) {
+        impl.destroy_self();
+    }
+
+    // Moves every item of `other` before `pos`.
+    void splice(const_iterator pos, List& other) noexcept {
+        splice(pos, other, other.cbegin(), other.cend());
+    }
+
+    // Moves the item at `it` in `other` before `pos`.
+    void splice(const_iterator pos, List& other, const_iterator it) noexcept {
+        FRANK_ASSERT(it.m_node != &other.impl.sentinel);
+        splice(pos, other, it, const_iterator(it.m_node->next));
+    }
+
+    // Moves [a, b) of `other` before `pos`. O(1): the nodes are relinked,
+    // not copied. `pos` must not lie inside [a, b).
+    void splice(
+        const_iterator pos,
+        List&          other,
+        const_iterator a,
+        const_iterator b) noexcept {
+        FRANK_ASSERT(
+            static_cast<Allocator&>(impl)
+            == static_cast<Allocator&>(other.impl));
+
+        if (a == b) {
+            return;
+        }
+
+        // Moving a range in front of itself or its successor changes nothing.
+        if (pos == a || pos == b) {
+            return;
         }
 
-        impl.tail->next = node;
-        node->prev      = impl.tail;
-        impl.tail       = node;
+        ListNodeBase* first = a.m_node;
+        ListNodeBase* last  = b.m_node->prev;
 
-        return node;
+        Impl::unlink(first, last);
+        Impl::link_before(first, last, pos.m_node);
     }
 };
+
+// A List whose nodes come from a PoolAllocator, BlockItems nodes per block.
+// Lists constructed from the same allocator share one pool. The blocks go back
+// to the heap when the last list or allocator copy sharing the pool is
+// destroyed; until then the nodes of a destroyed list are only recycled.
+template <typename T, size_t BlockItems = 256>
+using PooledList = List<T, PoolAllocator<ListNode<T>, BlockItems>>;
 }
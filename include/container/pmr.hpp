@@ -0,0 +1,30 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <memory_resource>
+
+#include "dynamic_array.hpp"
+#include "growth_policy.hpp"
+#include "list.hpp"
+
+// Containers over std::pmr::polymorphic_allocator. The memory resource is
+// picked at run time, so one container type serves arenas, pools and
+// tracking resources alike (see memory/memory_resource.hpp).
+//
+// A polymorphic allocator never propagates: copies of a container use the
+// default resource, and assigning or moving keeps the resource of the target.
+// Moving between containers on different resources moves the items one by
+// one instead of taking over the storage.
+namespace frank {
+namespace pmr {
+template <typename T, typename GrowthPolicy = GrowDouble<>>
+using DynamicArray = frank::
+    DynamicArray<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+
+template <typename T>
+using List = frank::List<T, std::pmr::polymorphic_allocator<ListNode<T>>>;
+}
+}
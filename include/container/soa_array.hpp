@@ -0,0 +1,605 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../internal/scope_guard.hpp"
+#include "../internal/type_traits.hpp"
+#include "../macro/assert.hpp"
+#include "../memory/aligned_allocator.hpp"
+#include "growth_policy.hpp"
+
+namespace frank {
+// Stores records of type (Ts...) as one contiguous array per field. All
+// fields live in a single block and share one capacity, so growing is one
+// allocation no matter how many fields there are. Every field array starts on
+// a 64 byte boundary of the block, which with the default AlignedAllocator
+// makes field<I>() safe for aligned vector loads.
+//
+// operator[] and the iterators hand out tuples of references, one per field,
+// and field<I>() exposes a single field as a span for per-field loops.
+template <typename Allocator, typename GrowthPolicy, typename... Ts>
+    requires(sizeof...(Ts) != 0)
+            && (std::move_constructible<Ts> && ...)
+            && (std::destructible<Ts> && ...)
+            && internal::IsGrowthPolicy<GrowthPolicy>
+class BasicSoAArray {
+public:
+    using value_type      = std::tuple<Ts...>;
+    using reference       = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+    using growth_policy   = GrowthPolicy;
+
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    static constexpr size_type field_count = sizeof...(Ts);
+
+    static constexpr size_type field_alignment
+        = std::max({size_t {64}, alignof(Ts)...});
+
+    static_assert(
+        std::is_same_v<typename std::allocator_traits<Allocator>::value_type,
+                       std::byte>,
+        "BasicSoAArray allocates raw bytes, use an allocator of std::byte");
+
+private:
+    using Indices = std::index_sequence_for<Ts...>;
+
+    template <bool Const>
+    class Iterator {
+    private:
+        using Owner
+            = std::conditional_t<Const, const BasicSoAArray, BasicSoAArray>;
+
+        Owner*    m_owner {nullptr};
+        size_type m_idx {0};
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = BasicSoAArray::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference = std::conditional_t<
+            Const,
+            const_reference,
+            BasicSoAArray::reference>;
+
+        Iterator() noexcept = default;
+
+        Iterator(Owner* owner, size_type idx) noexcept
+            : m_owner(owner)
+            , m_idx(idx) { }
+
+        operator Iterator<true>() const noexcept
+            requires(!Const)
+        {
+            return Iterator<true>(m_owner, m_idx);
+        }
+
+        reference operator*() const noexcept { return (*m_owner)[m_idx]; }
+
+        reference operator[](difference_type n) const noexcept {
+            return (*m_owner)[m_idx + n];
+        }
+
+        Iterator& operator++() noexcept {
+            ++m_idx;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++m_idx;
+            return old;
+        }
+
+        Iterator& operator--() noexcept {
+            --m_idx;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --m_idx;
+            return old;
+        }
+
+        Iterator& operator+=(difference_type n) noexcept {
+            m_idx += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) noexcept {
+            m_idx -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it) noexcept {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+
+        friend difference_type
+        operator-(const Iterator& a, const Iterator& b) noexcept {
+            return static_cast<difference_type>(a.m_idx)
+                   - static_cast<difference_type>(b.m_idx);
+        }
+
+        friend bool
+        operator==(const Iterator& a, const Iterator& b) noexcept {
+            return a.m_idx == b.m_idx;
+        }
+
+        friend auto
+        operator<=>(const Iterator& a, const Iterator& b) noexcept {
+            return a.m_idx <=> b.m_idx;
+        }
+    };
+
+public:
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    struct Impl : public Allocator {
+        std::byte*         block {nullptr};
+        size_type          block_bytes {0};
+        std::tuple<Ts*...> fields {};
+        size_type          size {0};
+        size_type          capacity {0};
+
+        ~Impl() noexcept((std::is_nothrow_destructible_v<Ts> && ...)) {
+            destroy_self();
+            deallocate_self();
+        }
+
+        Impl() noexcept(std::is_nothrow_constructible_v<Allocator>)
+            : Allocator() { }
+
+        Impl(const Allocator& a) noexcept(
+            std::is_nothrow_constructible_v<Allocator, decltype(a)>)
+            : Allocator(a) { }
+
+        Impl(const Impl&) = delete;
+        Impl(Impl&&)      = delete;
+
+        Impl& operator=(const Impl&) = delete;
+        Impl& operator=(Impl&&)      = delete;
+
+        // Bytes needed for `cap` records, with every field array padded up
+        // to field_alignment.
+        [[nodiscard]] static constexpr size_type
+        bytes_for(size_type cap) noexcept {
+            size_type bytes = 0;
+            ((bytes = align_up(bytes) + cap * sizeof(Ts)), ...);
+
+            return align_up(bytes);
+        }
+
+        [[nodiscard]] static constexpr size_type
+        align_up(size_type n) noexcept {
+            return (n + field_alignment - 1) / field_alignment
+                   * field_alignment;
+        }
+
+        [[nodiscard]] static std::tuple<Ts*...>
+        carve(std::byte* block, size_type cap) noexcept {
+            size_type offset = 0;
+
+            // Braced init evaluates left to right, keeping field order.
+            return std::tuple<Ts*...> {carve_one<Ts>(block, offset, cap)...};
+        }
+
+        template <typename U>
+        [[nodiscard]] static U*
+        carve_one(std::byte* block, size_type& offset, size_type cap) noexcept {
+            offset = align_up(offset);
+            U* p   = reinterpret_cast<U*>(block + offset);
+            offset += cap * sizeof(U);
+
+            return p;
+        }
+
+        void destroy_self() noexcept((std::is_nothrow_destructible_v<Ts>
+                                      && ...)) {
+            destroy_range(0, size);
+            size = 0;
+        }
+
+        void destroy_range(size_type a, size_type b) noexcept(
+            (std::is_nothrow_destructible_v<Ts> && ...)) {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (destroy_field(std::get<I>(fields), a, b), ...);
+            }(Indices {});
+        }
+
+        template <typename U>
+        static void destroy_field(U* p, size_type a, size_type b) noexcept(
+            std::is_nothrow_destructible_v<U>) {
+            if constexpr (!std::is_trivially_destructible_v<U>) {
+                std::destroy(p + a, p + b);
+            }
+        }
+
+        void deallocate_self() noexcept {
+            if (block != nullptr) {
+                std::allocator_traits<Allocator>::deallocate(
+                    static_cast<Allocator&>(*this), block, block_bytes);
+            }
+
+            block       = nullptr;
+            block_bytes = 0;
+            fields      = {};
+            capacity    = 0;
+        }
+
+        template <typename U>
+        static void relocate_field(U* from, U* to, size_type n) noexcept(
+            std::is_nothrow_move_constructible_v<U>) {
+            if constexpr (is_trivially_relocatable_v<U>) {
+                if (n != 0) {
+                    std::memcpy(
+                        static_cast<void*>(to),
+                        static_cast<const void*>(from),
+                        n * sizeof(U));
+                }
+            } else {
+                std::uninitialized_move(from, from + n, to);
+                std::destroy(from, from + n);
+            }
+        }
+
+        void reallocate_self(size_type cap) {
+            FRANK_ASSERT(cap >= size);
+
+            const size_type bytes = bytes_for(cap);
+            std::byte*      p     = std::allocator_traits<Allocator>::allocate(
+                static_cast<Allocator&>(*this), bytes);
+
+            std::tuple<Ts*...> to = carve(p, cap);
+
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (relocate_field(std::get<I>(fields), std::get<I>(to), size),
+                 ...);
+            }(Indices {});
+
+            const size_type n = size;
+            size              = 0;
+            deallocate_self();
+
+            block       = p;
+            block_bytes = bytes;
+            fields      = to;
+            size        = n;
+            capacity    = cap;
+        }
+
+        void steal(Impl& other) noexcept {
+            block       = std::exchange(other.block, nullptr);
+            block_bytes = std::exchange(other.block_bytes, 0);
+            fields      = std::exchange(other.fields, {});
+            size        = std::exchange(other.size, 0);
+            capacity    = std::exchange(other.capacity, 0);
+        }
+    };
+
+    Impl impl;
+
+public:
+    ~BasicSoAArray() = default;
+
+    BasicSoAArray() noexcept(std::is_nothrow_constructible_v<Impl>)
+        : impl() { }
+
+    explicit BasicSoAArray(const Allocator& a) noexcept(
+        std::is_nothrow_constructible_v<Impl, decltype(a)>)
+        : impl(a) { }
+
+    BasicSoAArray(const BasicSoAArray& other)
+        requires(std::copy_constructible<Ts> && ...)
+        : BasicSoAArray(
+              other,
+              std::allocator_traits<Allocator>::
+                  select_on_container_copy_construction(
+                      static_cast<const Allocator&>(other.impl))) { }
+
+    BasicSoAArray(const BasicSoAArray& other, const Allocator& a)
+        requires(std::copy_constructible<Ts> && ...)
+        : impl(a) {
+        if (other.is_empty()) {
+            return;
+        }
+
+        const size_type n = other.size();
+
+        impl.reallocate_self(n);
+
+        // Copy field by field; on failure undo the fields already copied.
+        size_type copied = 0;
+
+        internal::ScopeGuard guard([&]() { destroy_fields(copied, 0, n); });
+
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((std::uninitialized_copy_n(
+                  std::get<I>(other.impl.fields), n, std::get<I>(impl.fields)),
+              ++copied),
+             ...);
+        }(Indices {});
+
+        guard.dismiss();
+        impl.size = n;
+    }
+
+    BasicSoAArray(BasicSoAArray&& other) noexcept
+        : impl(std::move(static_cast<Allocator&>(other.impl))) {
+        impl.steal(other.impl);
+    }
+
+    BasicSoAArray& operator=(const BasicSoAArray& other)
+        requires(std::copy_constructible<Ts> && ...)
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_copy_assignment::value) {
+            BasicSoAArray copy(
+                other, static_cast<const Allocator&>(other.impl));
+            impl.destroy_self();
+            impl.deallocate_self();
+            static_cast<Allocator&>(impl) = static_cast<Allocator&>(copy.impl);
+            impl.steal(copy.impl);
+        } else {
+            BasicSoAArray copy(other, static_cast<const Allocator&>(impl));
+            impl.destroy_self();
+            impl.deallocate_self();
+            impl.steal(copy.impl);
+        }
+
+        return *this;
+    }
+
+    BasicSoAArray& operator=(BasicSoAArray&& other) noexcept(
+        (std::is_nothrow_destructible_v<Ts> && ...)
+        && (std::allocator_traits<
+                Allocator>::propagate_on_container_move_assignment::value ?
+                std::is_nothrow_move_assignable_v<Allocator> :
+                std::allocator_traits<Allocator>::is_always_equal::value)) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_move_assignment::value) {
+            impl.destroy_self();
+            impl.deallocate_self();
+            static_cast<Allocator&>(impl)
+                = std::move(static_cast<Allocator&>(other.impl));
+            impl.steal(other.impl);
+        } else if (can_free_storage_of(other)) {
+            impl.destroy_self();
+            impl.deallocate_self();
+            impl.steal(other.impl);
+        } else {
+            // The allocators differ and stay put (std::pmr), so the records
+            // have to move into storage from our own allocator.
+            clear();
+            reserve(other.size());
+
+            for (size_type i = 0; i < other.size(); ++i) {
+                std::apply(
+                    [this](Ts&... fields) { push_back(std::move(fields)...); },
+                    other[i]);
+            }
+
+            other.impl.destroy_self();
+            other.impl.deallocate_self();
+        }
+
+        return *this;
+    }
+
+public:
+    iterator       begin() noexcept { return iterator(this, 0); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    iterator       end() noexcept { return iterator(this, impl.size); }
+    const_iterator end() const noexcept {
+        return const_iterator(this, impl.size);
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reference operator[](size_type idx) noexcept {
+        return std::apply(
+            [idx](Ts*... p) { return reference(p[idx]...); }, impl.fields);
+    }
+
+    const_reference operator[](size_type idx) const noexcept {
+        return std::apply(
+            [idx](Ts*... p) { return const_reference(p[idx]...); },
+            impl.fields);
+    }
+
+    [[nodiscard]] std::optional<reference> at(size_type idx) noexcept {
+        return idx < size() ? std::optional<reference>((*this)[idx]) :
+                              std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<const_reference>
+    at(size_type idx) const noexcept {
+        return idx < size() ? std::optional<const_reference>((*this)[idx]) :
+                              std::nullopt;
+    }
+
+    // The whole of field I as one contiguous array.
+    template <size_t I>
+    [[nodiscard]] std::span<field_type<I>> field() noexcept {
+        return std::span<field_type<I>>(std::get<I>(impl.fields), impl.size);
+    }
+
+    template <size_t I>
+    [[nodiscard]] std::span<const field_type<I>> field() const noexcept {
+        return std::span<const field_type<I>>(
+            std::get<I>(impl.fields), impl.size);
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept { return impl.size == 0; }
+
+    [[nodiscard]] bool is_full() const noexcept {
+        return impl.size == impl.capacity;
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return impl.size; }
+
+    [[nodiscard]] size_type capacity() const noexcept {
+        return impl.capacity;
+    }
+
+    [[nodiscard]] Allocator allocator() const noexcept {
+        return static_cast<Allocator>(impl);
+    }
+
+public:
+    template <typename... Args>
+        requires(sizeof...(Args) == sizeof...(Ts))
+                && (std::constructible_from<Ts, Args &&> && ...)
+    void push_back(Args&&... args) {
+        if (is_full()) {
+            grow(GrowthPolicy::next_capacity(capacity(), record_size()));
+        }
+
+        construct_at(impl.size, Indices {}, std::forward<Args>(args)...);
+        ++impl.size;
+    }
+
+    void push_back(const value_type& record)
+        requires(std::copy_constructible<Ts> && ...)
+    {
+        std::apply(
+            [this](const Ts&... fields) { push_back(fields...); }, record);
+    }
+
+    void pop_back() noexcept((std::is_nothrow_destructible_v<Ts> && ...)) {
+        FRANK_ASSERT(!is_empty());
+
+        impl.destroy_range(impl.size - 1, impl.size);
+        --impl.size;
+    }
+
+    // Removes record `idx` by moving the last record into its place. O(1),
+    // but does not keep the order.
+    void swap_erase(size_type idx) noexcept(
+        (std::is_nothrow_move_assignable_v<Ts> && ...)
+        && (std::is_nothrow_destructible_v<Ts> && ...)) {
+        FRANK_ASSERT(idx < size());
+
+        if (idx != impl.size - 1) {
+            (*this)[idx] = std::apply(
+                [](Ts&... last) {
+                    return std::forward_as_tuple(std::move(last)...);
+                },
+                (*this)[impl.size - 1]);
+        }
+
+        pop_back();
+    }
+
+    void clear() noexcept((std::is_nothrow_destructible_v<Ts> && ...)) {
+        impl.destroy_self();
+    }
+
+    void reserve(size_type sz) {
+        if (sz > capacity()) {
+            grow(sz);
+        }
+    }
+
+    void grow(size_type sz) {
+        FRANK_ASSERT(sz > capacity());
+        impl.reallocate_self(sz);
+    }
+
+    void shrink_to_fit() {
+        if (is_empty()) {
+            impl.deallocate_self();
+        } else if (size() < capacity()) {
+            impl.reallocate_self(size());
+        }
+    }
+
+private:
+    template <size_t... I, typename... Args>
+    void
+    construct_at(size_type idx, std::index_sequence<I...>, Args&&... args) {
+        // Construct field by field; on failure undo the fields already built.
+        size_type built = 0;
+
+        internal::ScopeGuard guard([&]() { destroy_fields(built, idx, 1); });
+
+        ((std::construct_at(
+              std::get<I>(impl.fields) + idx, std::forward<Args>(args)),
+          ++built),
+         ...);
+
+        guard.dismiss();
+    }
+
+    // Destroys items [idx, idx + n) of the first `count` fields.
+    void destroy_fields(size_type count, size_type idx, size_type n) noexcept(
+        (std::is_nothrow_destructible_v<Ts> && ...)) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((I < count ?
+                  (void)std::destroy_n(std::get<I>(impl.fields) + idx, n) :
+                  void()),
+             ...);
+        }(Indices {});
+    }
+
+    // Whether our allocator may free storage allocated by that of `other`.
+    [[nodiscard]] bool
+    can_free_storage_of(const BasicSoAArray& other) const noexcept {
+        if constexpr (
+            std::allocator_traits<Allocator>::is_always_equal::value) {
+            return true;
+        } else {
+            return static_cast<const Allocator&>(impl)
+                   == static_cast<const Allocator&>(other.impl);
+        }
+    }
+
+    [[nodiscard]] static constexpr size_type record_size() noexcept {
+        return (sizeof(Ts) + ...);
+    }
+};
+
+template <typename... Ts>
+using SoAArray
+    = BasicSoAArray<AlignedAllocator<std::byte, 64>, GrowDouble<>, Ts...>;
+}
@@ -0,0 +1,464 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "../macro/assert.hpp"
+
+namespace frank {
+// A growable array whose items never move. Storage is a list of segments
+// that double in size: segment k holds FirstSegment << k items. Growing
+// appends a new segment and leaves the existing ones alone, so pointers and
+// references to items stay valid until the item is popped or the array is
+// cleared.
+//
+// Indexing is still O(1): with j = idx + FirstSegment, the segment is
+// bit_width(j) - 1 - log2(FirstSegment) and the offset is j with its top bit
+// cleared.
+template <
+    typename T,
+    typename Allocator  = std::allocator<T>,
+    size_t FirstSegment = 16>
+    requires std::move_constructible<T> && std::destructible<T>
+             && (std::has_single_bit(FirstSegment))
+class StableDynamicArray {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+    static_assert(
+        std::is_same_v<typename std::allocator_traits<Allocator>::pointer, T*>,
+        "StableDynamicArray requires an allocator with raw pointers");
+
+private:
+    static constexpr size_type first_shift = std::countr_zero(FirstSegment);
+
+    static constexpr size_type max_segments
+        = std::numeric_limits<size_type>::digits - first_shift;
+
+    template <bool Const>
+    class Iterator {
+    private:
+        using Owner = std::conditional_t<
+            Const,
+            const StableDynamicArray,
+            StableDynamicArray>;
+
+        Owner*    m_owner {nullptr};
+        size_type m_idx {0};
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() noexcept = default;
+
+        Iterator(Owner* owner, size_type idx) noexcept
+            : m_owner(owner)
+            , m_idx(idx) { }
+
+        operator Iterator<true>() const noexcept
+            requires(!Const)
+        {
+            return Iterator<true>(m_owner, m_idx);
+        }
+
+        reference operator*() const noexcept { return (*m_owner)[m_idx]; }
+        pointer   operator->() const noexcept { return &(*m_owner)[m_idx]; }
+
+        reference operator[](difference_type n) const noexcept {
+            return (*m_owner)[m_idx + n];
+        }
+
+        Iterator& operator++() noexcept {
+            ++m_idx;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++m_idx;
+            return old;
+        }
+
+        Iterator& operator--() noexcept {
+            --m_idx;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --m_idx;
+            return old;
+        }
+
+        Iterator& operator+=(difference_type n) noexcept {
+            m_idx += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) noexcept {
+            m_idx -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it) noexcept {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+
+        friend difference_type
+        operator-(const Iterator& a, const Iterator& b) noexcept {
+            return static_cast<difference_type>(a.m_idx)
+                   - static_cast<difference_type>(b.m_idx);
+        }
+
+        friend bool
+        operator==(const Iterator& a, const Iterator& b) noexcept {
+            return a.m_idx == b.m_idx;
+        }
+
+        friend auto
+        operator<=>(const Iterator& a, const Iterator& b) noexcept {
+            return a.m_idx <=> b.m_idx;
+        }
+    };
+
+public:
+    using iterator               = Iterator<false>;
+    using const_iterator         = Iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using iterator_category      = std::random_access_iterator_tag;
+
+private:
+    struct Impl : public Allocator {
+        pointer   segments[max_segments] {};
+        size_type size {0};
+        size_type segment_count {0};
+
+        ~Impl() noexcept(std::is_nothrow_destructible_v<T>) {
+            destroy_self();
+            deallocate_self();
+        }
+
+        Impl() noexcept(std::is_nothrow_constructible_v<Allocator>)
+            : Allocator() { }
+
+        Impl(const Allocator& a) noexcept(
+            std::is_nothrow_constructible_v<Allocator, decltype(a)>)
+            : Allocator(a) { }
+
+        Impl(const Impl&) = delete;
+        Impl(Impl&&)      = delete;
+
+        Impl& operator=(const Impl&) = delete;
+        Impl& operator=(Impl&&)      = delete;
+
+        [[nodiscard]] static constexpr size_type
+        segment_size(size_type k) noexcept {
+            return FirstSegment << k;
+        }
+
+        [[nodiscard]] pointer item(size_type idx) const noexcept {
+            const size_type j = idx + FirstSegment;
+            const size_type k = std::bit_width(j) - 1 - first_shift;
+
+            return segments[k] + (j - segment_size(k));
+        }
+
+        void allocate_segment() {
+            FRANK_ASSERT(segment_count < max_segments);
+
+            segments[segment_count]
+                = std::allocator_traits<Allocator>::allocate(
+                    static_cast<Allocator&>(*this),
+                    segment_size(segment_count));
+            ++segment_count;
+        }
+
+        void destroy_self() noexcept(std::is_nothrow_destructible_v<T>) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (size_type i = 0; i < size; ++i) {
+                    std::allocator_traits<Allocator>::destroy(
+                        static_cast<Allocator&>(*this), item(i));
+                }
+            }
+
+            size = 0;
+        }
+
+        void deallocate_self() noexcept {
+            for (size_type k = 0; k < segment_count; ++k) {
+                std::allocator_traits<Allocator>::deallocate(
+                    static_cast<Allocator&>(*this),
+                    segments[k],
+                    segment_size(k));
+                segments[k] = nullptr;
+            }
+
+            segment_count = 0;
+        }
+
+        void steal(Impl& other) noexcept {
+            for (size_type k = 0; k < max_segments; ++k) {
+                segments[k]       = other.segments[k];
+                other.segments[k] = nullptr;
+            }
+
+            size          = std::exchange(other.size, 0);
+            segment_count = std::exchange(other.segment_count, 0);
+        }
+    };
+
+    Impl impl;
+
+public:
+    ~StableDynamicArray() = default;
+
+    StableDynamicArray() noexcept(std::is_nothrow_constructible_v<Impl>)
+        : impl() { }
+
+    explicit StableDynamicArray(const Allocator& a) noexcept(
+        std::is_nothrow_constructible_v<Impl, decltype(a)>)
+        : impl(a) { }
+
+    StableDynamicArray(const StableDynamicArray& other)
+        requires std::copy_constructible<T>
+        : impl(std::allocator_traits<Allocator>::
+                   select_on_container_copy_construction(
+                       static_cast<const Allocator&>(other.impl))) {
+        reserve(other.size());
+
+        for (const T& item : other) {
+            push_back(item);
+        }
+    }
+
+    StableDynamicArray(StableDynamicArray&& other) noexcept
+        : impl(std::move(static_cast<Allocator&>(other.impl))) {
+        impl.steal(other.impl);
+    }
+
+    StableDynamicArray& operator=(const StableDynamicArray& other)
+        requires std::copy_constructible<T>
+    {
+        if (this != &other) {
+            StableDynamicArray copy(other);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    StableDynamicArray& operator=(StableDynamicArray&& other) noexcept(
+        std::is_nothrow_destructible_v<T>
+        && (std::allocator_traits<
+                Allocator>::propagate_on_container_move_assignment::value
+            || std::allocator_traits<Allocator>::is_always_equal::value)) {
+        if (this == &other) {
+            return *this;
+        }
+
+        impl.destroy_self();
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_move_assignment::value) {
+            impl.deallocate_self();
+
+            static_cast<Allocator&>(impl)
+                = std::move(static_cast<Allocator&>(other.impl));
+            impl.steal(other.impl);
+        } else if (can_free_storage_of(other)) {
+            impl.deallocate_self();
+            impl.steal(other.impl);
+        } else {
+            // The allocators differ and stay put (std::pmr), so the items
+            // have to move into segments from our own allocator.
+            reserve(other.size());
+
+            for (T& item : other) {
+                emplace_back(std::move(item));
+            }
+
+            other.clear();
+        }
+
+        return *this;
+    }
+
+public:
+    iterator       begin() noexcept { return iterator(this, 0); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    iterator       end() noexcept { return iterator(this, impl.size); }
+    const_iterator end() const noexcept {
+        return const_iterator(this, impl.size);
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    reference operator[](size_type idx) noexcept { return *impl.item(idx); }
+    const_reference operator[](size_type idx) const noexcept {
+        return *impl.item(idx);
+    }
+
+    [[nodiscard]] std::optional<reference> at(size_type idx) noexcept {
+        return idx < size() ? std::optional<reference>(*impl.item(idx)) :
+                              std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<const_reference>
+    at(size_type idx) const noexcept {
+        return idx < size() ? std::optional<const_reference>(*impl.item(idx)) :
+                              std::nullopt;
+    }
+
+    reference front_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *impl.item(0);
+    }
+    const_reference front_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *impl.item(0);
+    }
+
+    reference back_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *impl.item(impl.size - 1);
+    }
+    const_reference back_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *impl.item(impl.size - 1);
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept { return impl.size == 0; }
+
+    [[nodiscard]] size_type size() const noexcept { return impl.size; }
+
+    [[nodiscard]] size_type capacity() const noexcept {
+        return FirstSegment * ((size_type {1} << impl.segment_count) - 1);
+    }
+
+    [[nodiscard]] size_type segment_count() const noexcept {
+        return impl.segment_count;
+    }
+
+    [[nodiscard]] Allocator allocator() const noexcept {
+        return static_cast<Allocator>(impl);
+    }
+
+public:
+    void push_back(const T& item)
+        requires std::copy_constructible<T>
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item) { emplace_back(std::move(item)); }
+
+    // Returns the new item. Its address stays valid until it is popped.
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (impl.size == capacity()) {
+            impl.allocate_segment();
+        }
+
+        pointer p = impl.item(impl.size);
+        std::allocator_traits<Allocator>::construct(
+            static_cast<Allocator&>(impl), p, std::forward<Args>(args)...);
+        ++impl.size;
+
+        return *p;
+    }
+
+    void pop_back() noexcept(std::is_nothrow_destructible_v<T>) {
+        FRANK_ASSERT(!is_empty());
+
+        --impl.size;
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::allocator_traits<Allocator>::destroy(
+                static_cast<Allocator&>(impl), impl.item(impl.size));
+        }
+    }
+
+    // Destroys every item but keeps the segments for reuse.
+    void clear() noexcept(std::is_nothrow_destructible_v<T>) {
+        impl.destroy_self();
+    }
+
+    void reserve(size_type sz) {
+        while (capacity() < sz) {
+            impl.allocate_segment();
+        }
+    }
+
+    // Frees the segments that hold no items.
+    void shrink_to_fit() noexcept {
+        while (impl.segment_count != 0
+               && capacity() - Impl::segment_size(impl.segment_count - 1)
+                      >= impl.size) {
+            --impl.segment_count;
+
+            std::allocator_traits<Allocator>::deallocate(
+                static_cast<Allocator&>(impl),
+                impl.segments[impl.segment_count],
+                Impl::segment_size(impl.segment_count));
+            impl.segments[impl.segment_count] = nullptr;
+        }
+    }
+
+private:
+    // Whether our allocator may free segments allocated by that of `other`.
+    [[nodiscard]] bool
+    can_free_storage_of(const StableDynamicArray& other) const noexcept {
+        if constexpr (
+            std::allocator_traits<Allocator>::is_always_equal::value) {
+            return true;
+        } else {
+            return static_cast<const Allocator&>(impl)
+                   == static_cast<const Allocator&>(other.impl);
+        }
+    }
+};
+}
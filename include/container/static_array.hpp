@@ -0,0 +1,393 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "../internal/type_traits.hpp"
+#include "../macro/assert.hpp"
+
+namespace frank {
+// A DynamicArray look-alike with a fixed capacity of N items stored inside
+// the object. It never allocates; running out of room is a precondition
+// violation (see try_emplace_back for a checked alternative). Every member is
+// constexpr, so it also works as a scratch buffer in constant evaluation.
+template <typename T, size_t N>
+    requires std::move_constructible<T> && std::destructible<T> && (N != 0)
+class StaticArray {
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = std::reverse_iterator<T*>;
+    using const_reverse_iterator = std::reverse_iterator<const T*>;
+    using iterator_category      = std::contiguous_iterator_tag;
+
+private:
+    // A union leaves the items uninitialized until they are constructed one
+    // by one, and unlike a byte buffer it is usable in constant evaluation.
+    union Storage {
+        T items[N];
+
+        constexpr Storage() noexcept { }
+        constexpr ~Storage() noexcept { }
+    };
+
+    Storage   m_storage;
+    size_type m_size {0};
+
+public:
+    constexpr ~StaticArray() noexcept(std::is_nothrow_destructible_v<T>) {
+        destroy_range(0, m_size);
+    }
+
+    constexpr StaticArray() noexcept { }
+
+    constexpr StaticArray(const StaticArray& other) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+        requires std::copy_constructible<T>
+    {
+        for (; m_size < other.m_size; ++m_size) {
+            std::construct_at(slot(m_size), other[m_size]);
+        }
+    }
+
+    constexpr StaticArray(StaticArray&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        for (; m_size < other.m_size; ++m_size) {
+            std::construct_at(slot(m_size), std::move(other[m_size]));
+        }
+
+        other.clear();
+    }
+
+    constexpr StaticArray(std::initializer_list<T> il)
+        requires std::copy_constructible<T>
+    {
+        assign(il);
+    }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    constexpr StaticArray(It a, It b) {
+        assign(a, b);
+    }
+
+    constexpr StaticArray& operator=(const StaticArray& other)
+        requires std::copy_constructible<T>
+    {
+        if (this != &other) {
+            assign(other.cbegin(), other.cend());
+        }
+
+        return *this;
+    }
+
+    constexpr StaticArray& operator=(StaticArray&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>
+        && std::is_nothrow_destructible_v<T>) {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+
+        for (; m_size < other.m_size; ++m_size) {
+            std::construct_at(slot(m_size), std::move(other[m_size]));
+        }
+
+        other.clear();
+        return *this;
+    }
+
+    constexpr bool operator==(const StaticArray& other) const noexcept {
+        return size() == other.size()
+               && std::equal(cbegin(), cend(), other.cbegin());
+    }
+
+    constexpr auto operator<=>(const StaticArray& other) const
+        requires std::three_way_comparable<T>
+    {
+        return std::lexicographical_compare_three_way(
+            cbegin(),
+            cend(),
+            other.cbegin(),
+            other.cend(),
+            std::compare_three_way {});
+    }
+
+public:
+    constexpr iterator       begin() noexcept { return slot(0); }
+    constexpr const_iterator begin() const noexcept { return slot(0); }
+
+    constexpr iterator       end() noexcept { return slot(m_size); }
+    constexpr const_iterator end() const noexcept { return slot(m_size); }
+
+    constexpr reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    constexpr const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    constexpr reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    constexpr const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    constexpr const_iterator cbegin() const noexcept { return slot(0); }
+    constexpr const_iterator cend() const noexcept { return slot(m_size); }
+
+    constexpr const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    constexpr const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    constexpr reference operator[](size_type idx) noexcept {
+        return *slot(idx);
+    }
+    constexpr const_reference operator[](size_type idx) const noexcept {
+        return *slot(idx);
+    }
+
+    [[nodiscard]] constexpr std::optional<reference>
+    at(size_type idx) noexcept {
+        return is_idx_valid(idx) ? std::optional<reference>(*slot(idx)) :
+                                   std::nullopt;
+    }
+
+    [[nodiscard]] constexpr std::optional<const_reference>
+    at(size_type idx) const noexcept {
+        return is_idx_valid(idx) ? std::optional<const_reference>(*slot(idx)) :
+                                   std::nullopt;
+    }
+
+    [[nodiscard]] constexpr std::optional<reference> front() noexcept {
+        return is_empty() ? std::nullopt : std::optional<reference>(*slot(0));
+    }
+
+    [[nodiscard]] constexpr std::optional<const_reference>
+    front() const noexcept {
+        return is_empty() ? std::nullopt :
+                            std::optional<const_reference>(*slot(0));
+    }
+
+    constexpr reference front_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *slot(0);
+    }
+    constexpr const_reference front_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *slot(0);
+    }
+
+    [[nodiscard]] constexpr std::optional<reference> back() noexcept {
+        return is_empty() ? std::nullopt :
+                            std::optional<reference>(*slot(m_size - 1));
+    }
+
+    [[nodiscard]] constexpr std::optional<const_reference>
+    back() const noexcept {
+        return is_empty() ? std::nullopt :
+                            std::optional<const_reference>(*slot(m_size - 1));
+    }
+
+    constexpr reference back_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *slot(m_size - 1);
+    }
+    constexpr const_reference back_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return *slot(m_size - 1);
+    }
+
+    // Always false, the storage is part of the object. Kept for parity with
+    // DynamicArray.
+    [[nodiscard]] constexpr bool is_null() const noexcept { return false; }
+
+    [[nodiscard]] constexpr bool is_empty() const noexcept {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] constexpr bool is_full() const noexcept {
+        return m_size == N;
+    }
+
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return N; }
+
+    [[nodiscard]] static constexpr size_type max_size() noexcept { return N; }
+
+    constexpr T*       data() noexcept { return slot(0); }
+    constexpr const T* data() const noexcept { return slot(0); }
+
+public:
+    constexpr void push_back(const T& item)
+        requires std::copy_constructible<T>
+    {
+        emplace_back(item);
+    }
+
+    constexpr void push_back(T&& item) { emplace_back(std::move(item)); }
+
+    template <typename... Args>
+    constexpr void emplace_back(Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>) {
+        FRANK_ASSERT(!is_full());
+
+        std::construct_at(slot(m_size), std::forward<Args>(args)...);
+        ++m_size;
+    }
+
+    // Like emplace_back, but returns false instead of asserting when the
+    // array is full.
+    template <typename... Args>
+    [[nodiscard]] constexpr bool try_emplace_back(Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>) {
+        if (is_full()) {
+            return false;
+        }
+
+        emplace_back(std::forward<Args>(args)...);
+        return true;
+    }
+
+    constexpr void pop_back() noexcept(std::is_nothrow_destructible_v<T>) {
+        FRANK_ASSERT(!is_empty());
+
+        --m_size;
+        std::destroy_at(slot(m_size));
+    }
+
+    constexpr void insert(size_type idx, const T& item)
+        requires std::copy_constructible<T>
+    {
+        emplace(idx, item);
+    }
+
+    constexpr void insert(size_type idx, T&& item) {
+        emplace(idx, std::move(item));
+    }
+
+    template <typename... Args>
+    constexpr void emplace(size_type idx, Args&&... args) {
+        FRANK_ASSERT(idx <= m_size);
+        FRANK_ASSERT(!is_full());
+
+        if (idx == m_size) {
+            emplace_back(std::forward<Args>(args)...);
+            return;
+        }
+
+        // Built up front, args may refer to items that are about to move.
+        T tmp(std::forward<Args>(args)...);
+
+        if !consteval {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::memmove(
+                    static_cast<void*>(slot(idx + 1)),
+                    static_cast<const void*>(slot(idx)),
+                    (m_size - idx) * sizeof(T));
+                std::construct_at(slot(idx), std::move(tmp));
+                ++m_size;
+                return;
+            }
+        }
+
+        std::construct_at(slot(m_size), std::move(*slot(m_size - 1)));
+        std::move_backward(slot(idx), slot(m_size - 1), slot(m_size));
+        *slot(idx) = std::move(tmp);
+        ++m_size;
+    }
+
+    constexpr void assign(std::initializer_list<T> il)
+        requires std::copy_constructible<T>
+    {
+        assign(il.begin(), il.end());
+    }
+
+    template <typename It>
+        requires std::input_iterator<It>
+                 && std::convertible_to<std::iter_value_t<It>, T>
+    constexpr void assign(It a, It b) {
+        clear();
+
+        for (; a != b; ++a) {
+            emplace_back(*a);
+        }
+    }
+
+    constexpr void erase(size_type idx) noexcept(
+        std::is_nothrow_destructible_v<T>
+        && std::is_nothrow_move_assignable_v<T>) {
+        FRANK_ASSERT(is_idx_valid(idx));
+
+        if !consteval {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::destroy_at(slot(idx));
+                std::memmove(
+                    static_cast<void*>(slot(idx)),
+                    static_cast<const void*>(slot(idx + 1)),
+                    (m_size - idx - 1) * sizeof(T));
+                --m_size;
+                return;
+            }
+        }
+
+        std::move(slot(idx + 1), slot(m_size), slot(idx));
+        pop_back();
+    }
+
+    constexpr void clear() noexcept(std::is_nothrow_destructible_v<T>) {
+        destroy_range(0, m_size);
+        m_size = 0;
+    }
+
+private:
+    [[nodiscard]] constexpr T* slot(size_type idx) noexcept {
+        return m_storage.items + idx;
+    }
+
+    [[nodiscard]] constexpr const T* slot(size_type idx) const noexcept {
+        return m_storage.items + idx;
+    }
+
+    constexpr void destroy_range(size_type a, size_type b) noexcept(
+        std::is_nothrow_destructible_v<T>) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (; a != b; ++a) {
+                std::destroy_at(slot(a));
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr bool is_idx_valid(size_type idx) const noexcept {
+        return idx < m_size;
+    }
+};
+}
@@ -0,0 +1,712 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "../internal/type_traits.hpp"
+#include "../macro/assert.hpp"
+
+namespace frank {
+namespace internal {
+// Roughly two cache lines of items per node, never fewer than four.
+template <typename T>
+inline constexpr size_t unrolled_default_items
+    = std::max<size_t>(4, 128 / sizeof(T));
+}
+
+// The links and item count of an UnrolledListNode. An UnrolledList keeps one
+// of these, holding no items, as the end sentinel, so end() is just the
+// sentinel at index 0.
+struct UnrolledListNodeBase {
+    UnrolledListNodeBase* prev {nullptr};
+    UnrolledListNodeBase* next {nullptr};
+    size_t                count {0};
+};
+
+template <typename T, size_t K>
+struct UnrolledListNode : public UnrolledListNodeBase {
+
+    // Left uninitialized, the first `count` items are constructed by the
+    // owning list.
+    union {
+        T items[K];
+    };
+
+    ~UnrolledListNode() noexcept { }
+    UnrolledListNode() noexcept { }
+
+    UnrolledListNode(const UnrolledListNode&) = delete;
+    UnrolledListNode(UnrolledListNode&&)      = delete;
+
+    UnrolledListNode& operator=(const UnrolledListNode&) = delete;
+    UnrolledListNode& operator=(UnrolledListNode&&)      = delete;
+};
+
+// A doubly linked list of nodes holding up to K items each. Walking the list
+// is mostly a scan over contiguous arrays, while inserting or erasing in the
+// middle only shifts items inside one node: a full node is split in half, and
+// a node that drops below half full is merged with its successor when both
+// fit in one.
+//
+// The nodes are circular around a sentinel held by the list. Splicing another
+// list in is O(1) at a node boundary and O(K) otherwise, since the node at the
+// position has to be split first. Iterators are invalidated by any insertion
+// or erasure in the node they point into, but survive splice() otherwise.
+template <
+    typename T,
+    size_t K           = internal::unrolled_default_items<T>,
+    typename Allocator = std::allocator<UnrolledListNode<T, K>>>
+    requires std::move_constructible<T> && std::destructible<T>
+             && std::is_move_assignable_v<T> && (K >= 2)
+class UnrolledList {
+private:
+    using Node  = UnrolledListNode<T, K>;
+    using Links = UnrolledListNodeBase;
+
+public:
+    using value_type      = T;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type  = Allocator;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+    static constexpr size_type node_items = K;
+
+    static_assert(
+        std::is_same_v<typename std::allocator_traits<Allocator>::pointer,
+                       Node*>,
+        "UnrolledList requires an allocator of UnrolledListNode<T, K>");
+
+private:
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class UnrolledList;
+
+        Links*    m_node {nullptr};
+        size_type m_idx {0};
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() noexcept = default;
+
+        Iterator(Links* node, size_type idx) noexcept
+            : m_node(node)
+            , m_idx(idx) { }
+
+        operator Iterator<true>() const noexcept
+            requires(!Const)
+        {
+            return Iterator<true>(m_node, m_idx);
+        }
+
+        reference operator*() const noexcept {
+            return static_cast<Node*>(m_node)->items[m_idx];
+        }
+        pointer operator->() const noexcept {
+            return static_cast<Node*>(m_node)->items + m_idx;
+        }
+
+        Iterator& operator++() noexcept {
+            if (++m_idx == m_node->count) {
+                m_node = m_node->next;
+                m_idx  = 0;
+            }
+
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        Iterator& operator--() noexcept {
+            if (m_idx != 0) {
+                --m_idx;
+                return *this;
+            }
+
+            m_node = m_node->prev;
+            m_idx  = m_node->count - 1;
+
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        friend bool
+        operator==(const Iterator& a, const Iterator& b) noexcept {
+            return a.m_node == b.m_node && a.m_idx == b.m_idx;
+        }
+    };
+
+public:
+    using iterator               = Iterator<false>;
+    using const_iterator         = Iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using iterator_category      = std::bidirectional_iterator_tag;
+
+private:
+    struct Impl : public Allocator {
+        // sentinel.next is the head and sentinel.prev the tail. An empty list
+        // links the sentinel to itself.
+        Links     sentinel;
+        size_type size {0};
+        size_type node_count {0};
+
+        ~Impl() noexcept(std::is_nothrow_destructible_v<T>) { destroy_self(); }
+
+        Impl() noexcept(std::is_nothrow_constructible_v<Allocator>)
+            : Allocator() {
+            init_self_empty();
+        }
+
+        Impl(const Allocator& a) noexcept(
+            std::is_nothrow_constructible_v<Allocator, decltype(a)>)
+            : Allocator(a) {
+            init_self_empty();
+        }
+
+        Impl(const Impl&) = delete;
+        Impl(Impl&&)      = delete;
+
+        Impl& operator=(const Impl&) = delete;
+        Impl& operator=(Impl&&)      = delete;
+
+        [[nodiscard]] Links* end_node() const noexcept {
+            return const_cast<Links*>(&sentinel);
+        }
+
+        [[nodiscard]] Node* head() const noexcept {
+            return static_cast<Node*>(sentinel.next);
+        }
+
+        [[nodiscard]] Node* tail() const noexcept {
+            return static_cast<Node*>(sentinel.prev);
+        }
+
+        void init_self_empty() noexcept {
+            sentinel.prev = &sentinel;
+            sentinel.next = &sentinel;
+        }
+
+        void destroy_self() noexcept(std::is_nothrow_destructible_v<T>) {
+            Links* it = sentinel.next;
+
+            while (it != &sentinel) {
+                Links* next = it->next;
+
+                destroy_items(static_cast<Node*>(it), 0, it->count);
+                deallocate_node(static_cast<Node*>(it));
+
+                it = next;
+            }
+
+            init_self_empty();
+            size       = 0;
+            node_count = 0;
+        }
+
+        [[nodiscard]] Node* allocate_node() {
+            Node* node = std::allocator_traits<Allocator>::allocate(
+                static_cast<Allocator&>(*this), 1);
+            std::construct_at(node);
+            ++node_count;
+
+            return node;
+        }
+
+        void deallocate_node(Node* node) noexcept {
+            std::destroy_at(node);
+            std::allocator_traits<Allocator>::deallocate(
+                static_cast<Allocator&>(*this), node, 1);
+            --node_count;
+        }
+
+        static void
+        destroy_items(Node* node, size_type a, size_type b) noexcept(
+            std::is_nothrow_destructible_v<T>) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy(node->items + a, node->items + b);
+            }
+        }
+
+        // Links the chain [first, last] in front of `next`, which may be the
+        // sentinel.
+        static void
+        link_before(Links* first, Links* last, Links* next) noexcept {
+            Links* prev = next->prev;
+
+            first->prev = prev;
+            last->next  = next;
+            prev->next  = first;
+            next->prev  = last;
+        }
+
+        static void unlink(Links* node) noexcept {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+        }
+
+        // Takes the nodes of `other`. Must be empty.
+        void steal(Impl& other) noexcept {
+            FRANK_ASSERT(size == 0);
+
+            if (other.size == 0) {
+                return;
+            }
+
+            Links* first = other.sentinel.next;
+            Links* last  = other.sentinel.prev;
+
+            other.init_self_empty();
+            link_before(first, last, &sentinel);
+
+            size       = std::exchange(other.size, 0);
+            node_count = std::exchange(other.node_count, 0);
+        }
+
+        // Moves items [a, count) of `from` to the end of `to`.
+        static void
+        relocate_items(Node* from, size_type a, Node* to) noexcept(
+            std::is_nothrow_move_constructible_v<T>) {
+            const size_type n = from->count - a;
+
+            if constexpr (is_trivially_relocatable_v<T>) {
+                if (n != 0) {
+                    std::memcpy(
+                        static_cast<void*>(to->items + to->count),
+                        static_cast<const void*>(from->items + a),
+                        n * sizeof(T));
+                }
+            } else {
+                std::uninitialized_move(
+                    from->items + a,
+                    from->items + from->count,
+                    to->items + to->count);
+                std::destroy(from->items + a, from->items + from->count);
+            }
+
+            to->count += n;
+            from->count = a;
+        }
+
+        // Moves items [idx, count) of `node` into a new node linked after it.
+        Node* split(Node* node, size_type idx) {
+            Node* rest = allocate_node();
+            link_before(rest, rest, node->next);
+            relocate_items(node, idx, rest);
+
+            return rest;
+        }
+    };
+
+    Impl impl;
+
+public:
+    ~UnrolledList() = default;
+
+    UnrolledList() noexcept(std::is_nothrow_constructible_v<Impl>)
+        : impl() { }
+
+    explicit UnrolledList(const Allocator& a) noexcept(
+        std::is_nothrow_constructible_v<Impl, decltype(a)>)
+        : impl(a) { }
+
+    UnrolledList(const UnrolledList& other)
+        requires std::copy_constructible<T>
+        : UnrolledList(
+              other,
+              std::allocator_traits<Allocator>::
+                  select_on_container_copy_construction(
+                      static_cast<const Allocator&>(other.impl))) { }
+
+    UnrolledList(const UnrolledList& other, const Allocator& a)
+        requires std::copy_constructible<T>
+        : impl(a) {
+        for (const T& item : other) {
+            push_back(item);
+        }
+    }
+
+    // The allocator is copied rather than moved so `other` stays usable.
+    UnrolledList(UnrolledList&& other) noexcept
+        : impl(static_cast<const Allocator&>(other.impl)) {
+        impl.steal(other.impl);
+    }
+
+    UnrolledList& operator=(const UnrolledList& other)
+        requires std::copy_constructible<T>
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_copy_assignment::value) {
+            UnrolledList copy(other, static_cast<const Allocator&>(other.impl));
+            impl.destroy_self();
+            static_cast<Allocator&>(impl) = static_cast<Allocator&>(copy.impl);
+            impl.steal(copy.impl);
+        } else {
+            UnrolledList copy(other, static_cast<const Allocator&>(impl));
+            impl.destroy_self();
+            impl.steal(copy.impl);
+        }
+
+        return *this;
+    }
+
+    // Without propagation the allocator stays put (std::pmr), and if it
+    // differs from that of `other` the items are moved over one by one.
+    UnrolledList& operator=(UnrolledList&& other) noexcept(
+        std::is_nothrow_destructible_v<T>
+        && (std::allocator_traits<
+                Allocator>::propagate_on_container_move_assignment::value
+            || std::allocator_traits<Allocator>::is_always_equal::value)) {
+        if (this == &other) {
+            return *this;
+        }
+
+        impl.destroy_self();
+
+        if constexpr (std::allocator_traits<Allocator>::
+                          propagate_on_container_move_assignment::value) {
+            static_cast<Allocator&>(impl)
+                = static_cast<Allocator&>(other.impl);
+        } else if (static_cast<Allocator&>(impl)
+                   != static_cast<Allocator&>(other.impl)) {
+            for (T& item : other) {
+                emplace_back(std::move(item));
+            }
+
+            other.clear();
+            return *this;
+        }
+
+        impl.steal(other.impl);
+
+        return *this;
+    }
+
+public:
+    iterator       begin() noexcept { return iterator(impl.sentinel.next, 0); }
+    const_iterator begin() const noexcept {
+        return const_iterator(impl.sentinel.next, 0);
+    }
+
+    iterator       end() noexcept { return iterator(impl.end_node(), 0); }
+    const_iterator end() const noexcept {
+        return const_iterator(impl.end_node(), 0);
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    reference front_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return impl.head()->items[0];
+    }
+    const_reference front_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return impl.head()->items[0];
+    }
+
+    reference back_unsafe() noexcept {
+        FRANK_ASSERT(!is_empty());
+        return impl.tail()->items[impl.tail()->count - 1];
+    }
+    const_reference back_unsafe() const noexcept {
+        FRANK_ASSERT(!is_empty());
+        return impl.tail()->items[impl.tail()->count - 1];
+    }
+
+    [[nodiscard]] bool is_empty() const noexcept { return impl.size == 0; }
+
+    [[nodiscard]] size_type size() const noexcept { return impl.size; }
+
+    [[nodiscard]] size_type node_count() const noexcept {
+        return impl.node_count;
+    }
+
+    [[nodiscard]] Allocator allocator() const noexcept {
+        return static_cast<Allocator>(impl);
+    }
+
+    // Calls `f` with each node's items as one span, front to back. The
+    // cheapest way to visit every item.
+    template <typename F>
+        requires std::invocable<F&, std::span<T>>
+    void for_each_chunk(F&& f) {
+        for (Links* it = impl.sentinel.next; it != &impl.sentinel;) {
+            Node* node = static_cast<Node*>(it);
+            it         = it->next;
+            f(std::span<T>(node->items, node->count));
+        }
+    }
+
+    template <typename F>
+        requires std::invocable<F&, std::span<const T>>
+    void for_each_chunk(F&& f) const {
+        for (const Links* it = impl.sentinel.next; it != &impl.sentinel;) {
+            const Node* node = static_cast<const Node*>(it);
+            it               = it->next;
+            f(std::span<const T>(node->items, node->count));
+        }
+    }
+
+public:
+    void push_back(const T& item)
+        requires std::copy_constructible<T>
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item) { emplace_back(std::move(item)); }
+
+    void push_front(const T& item)
+        requires std::copy_constructible<T>
+    {
+        emplace_front(item);
+    }
+
+    void push_front(T&& item) { emplace_front(std::move(item)); }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (impl.size == 0 || impl.tail()->count == K) {
+            Node* node = impl.allocate_node();
+            impl.link_before(node, node, &impl.sentinel);
+        }
+
+        Node* node = impl.tail();
+        std::construct_at(
+            node->items + node->count, std::forward<Args>(args)...);
+        ++node->count;
+        ++impl.size;
+
+        return node->items[node->count - 1];
+    }
+
+    template <typename... Args>
+    reference emplace_front(Args&&... args) {
+        return *emplace(cbegin(), std::forward<Args>(args)...);
+    }
+
+    iterator insert(const_iterator pos, const T& item)
+        requires std::copy_constructible<T>
+    {
+        return emplace(pos, item);
+    }
+
+    iterator insert(const_iterator pos, T&& item) {
+        return emplace(pos, std::move(item));
+    }
+
+    // Constructs an item before `pos`. Only the items of one node are
+    // shifted; a full node is split in half first.
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        if (pos.m_node == &impl.sentinel) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(impl.tail(), impl.tail()->count - 1);
+        }
+
+        // Built up front, args may refer to items that are about to move.
+        T tmp(std::forward<Args>(args)...);
+
+        Node*     node = static_cast<Node*>(pos.m_node);
+        size_type idx  = pos.m_idx;
+
+        if (node->count == K) {
+            if (idx == 0 && node->prev != &impl.sentinel
+                && node->prev->count < K) {
+                // Room at the end of the previous node, nothing to shift.
+                node = static_cast<Node*>(node->prev);
+                idx  = node->count;
+            } else {
+                Node* rest = impl.split(node, K / 2);
+
+                if (idx > K / 2) {
+                    node = rest;
+                    idx -= K / 2;
+                }
+            }
+        }
+
+        insert_at(node, idx, std::move(tmp));
+        ++impl.size;
+
+        return iterator(node, idx);
+    }
+
+    void pop_front() noexcept(
+        std::is_nothrow_destructible_v<T>
+        && std::is_nothrow_move_assignable_v<T>) {
+        FRANK_ASSERT(!is_empty());
+        erase(cbegin());
+    }
+
+    void pop_back() noexcept(std::is_nothrow_destructible_v<T>) {
+        FRANK_ASSERT(!is_empty());
+
+        Node* node = impl.tail();
+        --node->count;
+        Impl::destroy_items(node, node->count, node->count + 1);
+        --impl.size;
+
+        if (node->count == 0) {
+            impl.unlink(node);
+            impl.deallocate_node(node);
+        }
+    }
+
+    // Erases the item at `pos` and returns an iterator to the one after it.
+    iterator erase(const_iterator pos) noexcept(
+        std::is_nothrow_destructible_v<T>
+        && std::is_nothrow_move_assignable_v<T>) {
+        FRANK_ASSERT(pos.m_node != &impl.sentinel);
+
+        Node*     node = static_cast<Node*>(pos.m_node);
+        size_type idx  = pos.m_idx;
+
+        erase_at(node, idx);
+        --impl.size;
+
+        if (node->count == 0) {
+            Links* next = node->next;
+            impl.unlink(node);
+            impl.deallocate_node(node);
+
+            return iterator(next, 0);
+        }
+
+        Links* next = node->next;
+
+        if (next != &impl.sentinel && node->count < K / 2
+            && node->count + next->count <= K) {
+            Impl::relocate_items(static_cast<Node*>(next), 0, node);
+            impl.unlink(next);
+            impl.deallocate_node(static_cast<Node*>(next));
+        }
+
+        if (idx == node->count) {
+            return iterator(node->next, 0);
+        }
+
+        return iterator(node, idx);
+    }
+
+    // Moves every item of `other` before `pos`. Nodes change owners without
+    // being copied: O(1) at a node boundary, otherwise the node at `pos` is
+    // split first. The allocators must compare equal.
+    void splice(const_iterator pos, UnrolledList& other) {
+        FRANK_ASSERT(
+            static_cast<Allocator&>(impl)
+            == static_cast<Allocator&>(other.impl));
+
+        if (&other == this || other.is_empty()) {
+            return;
+        }
+
+        Links* next = pos.m_node;
+
+        if (next != &impl.sentinel && pos.m_idx != 0) {
+            next = impl.split(static_cast<Node*>(next), pos.m_idx);
+        }
+
+        Links* first = other.impl.sentinel.next;
+        Links* last  = other.impl.sentinel.prev;
+
+        other.impl.init_self_empty();
+        Impl::link_before(first, last, next);
+
+        impl.size += std::exchange(other.impl.size, 0);
+        impl.node_count += std::exchange(other.impl.node_count, 0);
+    }
+
+    void clear() noexcept(std::is_nothrow_destructible_v<T>) {
+        impl.destroy_self();
+    }
+
+private:
+    static void insert_at(Node* node, size_type idx, T&& item) {
+        FRANK_ASSERT(node->count < K && idx <= node->count);
+
+        T* items = node->items;
+
+        if (idx == node->count) {
+            std::construct_at(items + idx, std::move(item));
+        } else if constexpr (is_trivially_relocatable_v<T>) {
+            std::memmove(
+                static_cast<void*>(items + idx + 1),
+                static_cast<const void*>(items + idx),
+                (node->count - idx) * sizeof(T));
+            std::construct_at(items + idx, std::move(item));
+        } else {
+            std::construct_at(
+                items + node->count, std::move(items[node->count - 1]));
+            std::move_backward(
+                items + idx, items + node->count - 1, items + node->count);
+            items[idx] = std::move(item);
+        }
+
+        ++node->count;
+    }
+
+    static void erase_at(Node* node, size_type idx) noexcept(
+        std::is_nothrow_destructible_v<T>
+        && std::is_nothrow_move_assignable_v<T>) {
+        T* items = node->items;
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            Impl::destroy_items(node, idx, idx + 1);
+            std::memmove(
+                static_cast<void*>(items + idx),
+                static_cast<const void*>(items + idx + 1),
+                (node->count - idx - 1) * sizeof(T));
+        } else {
+            std::move(items + idx + 1, items + node->count, items + idx);
+            Impl::destroy_items(node, node->count - 1, node->count);
+        }
+
+        --node->count;
+    }
+};
+}
@@ -6,10 +6,32 @@
 
 #include <concepts>
 #include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
 namespace frank {
+// A type is trivially relocatable if moving an object to a new address and
+// ending the lifetime of the old one can be done with a plain memcpy of its
+// bytes. Every trivially copyable type is. Many other types are too, for
+// example types that only hold std::unique_ptr or handles, but the compiler
+// cannot prove it; such types opt in by specializing this trait:
+//
+//     template <>
+//     struct frank::is_trivially_relocatable<Mesh> : std::true_type { };
+//
+// Do not opt in types that store pointers into themselves.
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> { };
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type { };
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v
+    = is_trivially_relocatable<T>::value;
+
 namespace internal {
 template <typename T>
 concept NoArgCallable = requires(T&& t) {
@@ -30,5 +52,18 @@ template <typename Allocator>
 concept HasMaxSize = requires(const Allocator& a) {
     { a.max_size() } -> std::convertible_to<std::size_t>;
 };
+
+// Mirrors std::allocator_traits::allocate_at_least, which is not available
+// in every standard library yet.
+template <typename Allocator, typename SizeType>
+concept HasAllocateAtLeast = requires(Allocator& a, SizeType n) {
+    { a.allocate_at_least(n).ptr };
+    { a.allocate_at_least(n).count } -> std::convertible_to<SizeType>;
+};
+
+template <typename Allocator, typename Pointer, typename SizeType>
+concept HasReallocate = requires(Allocator& a, Pointer p, SizeType n) {
+    { a.reallocate(p, n, n) } -> std::same_as<Pointer>;
+};
 }
 }
@@ -0,0 +1,185 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "../container/dynamic_array.hpp"
+#include "../macro/assert.hpp"
+
+namespace frank {
+// Tick at which a row was last written. Ticks only ever grow, so a row
+// changed after tick `since` iff its tick is greater than `since`.
+using ChangeTick = std::uint32_t;
+
+// A run of consecutive changed rows.
+struct DeltaRange {
+    std::uint64_t first;
+    std::uint64_t count;
+};
+
+// The changed rows of one column, run length encoded by row range. The
+// payload holds the new bytes of every range back to back, so applying a
+// delta is one memcpy per range.
+class ColumnDelta {
+private:
+    std::uint32_t                m_item_size {0};
+    std::uint64_t                m_rows {0};
+    DynamicArray<DeltaRange>     m_ranges;
+    std::unique_ptr<std::byte[]> m_bytes;
+    size_t                       m_byte_count {0};
+
+public:
+    ~ColumnDelta() = default;
+
+    ColumnDelta() = default;
+
+    ColumnDelta(ColumnDelta&&) noexcept            = default;
+    ColumnDelta& operator=(ColumnDelta&&) noexcept = default;
+
+    ColumnDelta(const ColumnDelta&)            = delete;
+    ColumnDelta& operator=(const ColumnDelta&) = delete;
+
+    // Collects every row whose tick is newer than `since`. `ticks` holds one
+    // tick per row of `column`.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] static ColumnDelta from_ticks(
+        std::span<const T>          column,
+        std::span<const ChangeTick> ticks,
+        ChangeTick                  since) {
+        FRANK_ASSERT(column.size() == ticks.size());
+
+        ColumnDelta delta(sizeof(T), column.size());
+
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            if (ticks[i] > since) {
+                delta.mark(i);
+            }
+        }
+
+        delta.capture(column);
+        return delta;
+    }
+
+    // Collects every row that differs between `before` and `after`. Rows past
+    // the end of `before` count as changed, rows past the end of `after` are
+    // dropped by the delta.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] static ColumnDelta
+    from_diff(std::span<const T> before, std::span<const T> after) {
+        ColumnDelta delta(sizeof(T), after.size());
+
+        const size_t common = std::min(before.size(), after.size());
+        for (size_t i = 0; i < common; ++i) {
+            if (std::memcmp(&before[i], &after[i], sizeof(T)) != 0) {
+                delta.mark(i);
+            }
+        }
+
+        for (size_t i = common; i < after.size(); ++i) {
+            delta.mark(i);
+        }
+
+        delta.capture(after);
+        return delta;
+    }
+
+public:
+    [[nodiscard]] bool is_empty() const noexcept { return m_ranges.is_empty(); }
+
+    // Number of rows in the column the delta was taken from. A column must
+    // have exactly this many rows before the delta is applied to it.
+    [[nodiscard]] std::uint64_t rows() const noexcept { return m_rows; }
+
+    [[nodiscard]] std::uint32_t item_size() const noexcept {
+        return m_item_size;
+    }
+
+    [[nodiscard]] std::span<const DeltaRange> ranges() const noexcept {
+        return std::span<const DeltaRange>(
+            m_ranges.cbegin(), m_ranges.cend());
+    }
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+        return std::span<const std::byte>(m_bytes.get(), m_byte_count);
+    }
+
+    [[nodiscard]] size_t changed_rows() const noexcept {
+        return m_byte_count / (m_item_size == 0 ? 1 : m_item_size);
+    }
+
+    // Copies the changed rows into `column`. Returns false and leaves the
+    // column untouched if the item size or row count does not match.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool apply(std::span<T> column) const noexcept {
+        if (sizeof(T) != m_item_size || column.size() != m_rows) {
+            return false;
+        }
+
+        const std::byte* src = m_bytes.get();
+        for (const DeltaRange& range : m_ranges) {
+            const size_t n = range.count * sizeof(T);
+
+            std::memcpy(
+                static_cast<void*>(column.data() + range.first), src, n);
+            src += n;
+        }
+
+        return true;
+    }
+
+private:
+    ColumnDelta(std::uint32_t item_size, std::uint64_t rows)
+        : m_item_size(item_size)
+        , m_rows(rows) { }
+
+    // Rows must be marked in ascending order.
+    void mark(size_t row) {
+        if (!m_ranges.is_empty()) {
+            DeltaRange& last = m_ranges.back_unsafe();
+
+            if (last.first + last.count == row) {
+                ++last.count;
+                return;
+            }
+        }
+
+        m_ranges.push_back(DeltaRange {.first = row, .count = 1});
+    }
+
+    template <typename T>
+    void capture(std::span<const T> column) {
+        size_t rows = 0;
+        for (const DeltaRange& range : m_ranges) {
+            rows += range.count;
+        }
+
+        if (rows == 0) {
+            return;
+        }
+
+        m_byte_count = rows * sizeof(T);
+        m_bytes      = std::make_unique_for_overwrite<std::byte[]>(
+            m_byte_count);
+
+        std::byte* dest = m_bytes.get();
+        for (const DeltaRange& range : m_ranges) {
+            const size_t n = range.count * sizeof(T);
+
+            std::memcpy(dest, column.data() + range.first, n);
+            dest += n;
+        }
+    }
+};
+}
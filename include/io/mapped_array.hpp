@@ -0,0 +1,366 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../container/dynamic_array.hpp"
+#include "../macro/assert.hpp"
+
+namespace frank {
+namespace internal {
+// File layout:
+//
+//   MappedArrayHeader, padded to mapped_array_data_offset
+//   capacity items
+//
+// Like snapshots, items are stored as their raw object representation in
+// host byte order.
+struct MappedArrayHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t item_size;
+    std::uint32_t item_align;
+    std::uint32_t reserved;
+    std::uint64_t size;
+    std::uint64_t capacity;
+};
+
+inline constexpr char mapped_array_magic[8]
+    = {'F', 'R', 'A', 'N', 'K', 'A', 'R', 'R'};
+
+inline constexpr std::uint32_t mapped_array_version = 1;
+
+// Keeps the items page aligned.
+inline constexpr size_t mapped_array_data_offset = 4096;
+
+// An open file mapped shared from offset 0. The mapping covers the header
+// and the current capacity and follows the file as it is resized.
+class MappedFile {
+private:
+    int        m_fd {-1};
+    std::byte* m_base {nullptr};
+    size_t     m_length {0};
+    bool       m_in_use {false};
+
+public:
+    ~MappedFile() noexcept {
+        if (m_base != nullptr) {
+            ::munmap(m_base, m_length);
+        }
+
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    explicit MappedFile(int fd) noexcept
+        : m_fd(fd) { }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&)      = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&)      = delete;
+
+public:
+    [[nodiscard]] MappedArrayHeader* header() const noexcept {
+        return reinterpret_cast<MappedArrayHeader*>(m_base);
+    }
+
+    [[nodiscard]] std::byte* data() const noexcept {
+        return m_base + mapped_array_data_offset;
+    }
+
+    // Whether a container currently owns the data region.
+    [[nodiscard]] bool is_in_use() const noexcept { return m_in_use; }
+
+    void set_in_use(bool in_use) noexcept { m_in_use = in_use; }
+
+    // Resizes the file to hold `data_bytes` after the header and remaps it.
+    // The data may move in memory, its contents are kept.
+    [[nodiscard]] bool resize(size_t data_bytes) noexcept {
+        const size_t file_size = mapped_array_data_offset + data_bytes;
+
+        if (::ftruncate(m_fd, static_cast<off_t>(file_size)) != 0) {
+            return false;
+        }
+
+        return map(file_size);
+    }
+
+    [[nodiscard]] bool map(size_t file_size) noexcept {
+        const size_t length = page_round(file_size);
+
+        if (length == m_length) {
+            return true;
+        }
+
+        void* p = MAP_FAILED;
+
+        if (m_base == nullptr) {
+            p = ::mmap(
+                nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        } else {
+#if defined(__linux__)
+            p = ::mremap(m_base, m_length, length, MREMAP_MAYMOVE);
+#else
+            // A shared mapping keeps its contents in the file, so mapping
+            // the file again loses nothing.
+            ::munmap(m_base, m_length);
+            p = ::mmap(
+                nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+#endif
+        }
+
+        if (p == MAP_FAILED) {
+            return false;
+        }
+
+        m_base   = static_cast<std::byte*>(p);
+        m_length = length;
+
+        return true;
+    }
+
+    [[nodiscard]] bool sync() const noexcept {
+        return m_base == nullptr || ::msync(m_base, m_length, MS_SYNC) == 0;
+    }
+
+private:
+    [[nodiscard]] static size_t page_round(size_t bytes) noexcept {
+        static const size_t page
+            = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+        return (bytes + page - 1) / page * page;
+    }
+};
+}
+
+// Backs a single DynamicArray with the data region of a mapped file. Growing
+// the array resizes the file with ftruncate and the mapping with mremap, so
+// the array can outgrow RAM and its pages are written back by the kernel.
+// Freeing leaves the file alone.
+//
+// A file holds one block at a time, which is all a DynamicArray needs: it
+// only ever allocates again after freeing or through reallocate(). Asking a
+// file for a second block throws std::bad_alloc, and so does copying a
+// DynamicArray that uses the allocator, since the copy would have to share
+// the file. Copy the items into an array with a regular allocator instead.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class FileAllocator {
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+private:
+    std::shared_ptr<internal::MappedFile> m_file;
+
+public:
+    explicit FileAllocator(std::shared_ptr<internal::MappedFile> file) noexcept
+        : m_file(std::move(file)) { }
+
+    // No move constructor on purpose; a moved-from DynamicArray keeps a
+    // usable allocator.
+    FileAllocator(const FileAllocator&) noexcept = default;
+
+    FileAllocator& operator=(const FileAllocator&) noexcept = default;
+
+    bool operator==(const FileAllocator& other) const noexcept {
+        return m_file == other.m_file;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) {
+        if (m_file->is_in_use()) {
+            throw std::bad_alloc();
+        }
+
+        T* p = resize(n);
+        m_file->set_in_use(true);
+
+        return p;
+    }
+
+    // The file keeps its size and contents, the block is only given up.
+    void deallocate(T*, size_t) noexcept { m_file->set_in_use(false); }
+
+    [[nodiscard]] T* reallocate(T*, size_t, size_t new_n) {
+        FRANK_ASSERT(m_file->is_in_use());
+        return resize(new_n);
+    }
+
+    [[noreturn]] FileAllocator select_on_container_copy_construction() const {
+        throw std::bad_alloc();
+    }
+
+    [[nodiscard]] const std::shared_ptr<internal::MappedFile>&
+    file() const noexcept {
+        return m_file;
+    }
+
+private:
+    [[nodiscard]] T* resize(size_t n) {
+        if (!m_file->resize(n * sizeof(T))) {
+            throw std::bad_alloc();
+        }
+
+        m_file->header()->capacity = n;
+        return reinterpret_cast<T*>(m_file->data());
+    }
+};
+
+// A DynamicArray whose items live in a file. open() maps an existing file
+// without reading or parsing it, so a large table is usable as soon as the
+// call returns and pages are faulted in as they are touched.
+//
+// The item count is written to the file by sync() and when the MappedArray
+// is destroyed; capacity is tracked as the array grows. Items written after
+// the last sync() may be lost on a crash.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class MappedArray {
+public:
+    using array_type = DynamicArray<T, FileAllocator<T>>;
+
+private:
+    std::shared_ptr<internal::MappedFile> m_file;
+    array_type                            m_items;
+
+    MappedArray(std::shared_ptr<internal::MappedFile> file, array_type items)
+        : m_file(std::move(file))
+        , m_items(std::move(items)) { }
+
+public:
+    ~MappedArray() noexcept {
+        if (m_file != nullptr) {
+            store_size();
+        }
+    }
+
+    MappedArray(const MappedArray&) = delete;
+
+    MappedArray(MappedArray&& other) noexcept
+        : m_file(std::move(other.m_file))
+        , m_items(std::move(other.m_items)) { }
+
+    MappedArray& operator=(const MappedArray&) = delete;
+    MappedArray& operator=(MappedArray&&)      = delete;
+
+    // Opens the array stored at `path`, creating an empty one if the file
+    // does not exist. Returns std::nullopt if the file cannot be opened or
+    // mapped, or holds items of a different layout.
+    [[nodiscard]] static std::optional<MappedArray> open(const char* path) {
+        const int fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        auto file = std::make_shared<internal::MappedFile>(fd);
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            return std::nullopt;
+        }
+
+        const size_t file_size = static_cast<size_t>(st.st_size);
+
+        if (file_size == 0) {
+            if (!file->resize(0)) {
+                return std::nullopt;
+            }
+
+            init_header(*file->header());
+            return MappedArray(file, array_type(FileAllocator<T>(file)));
+        }
+
+        if (file_size < internal::mapped_array_data_offset
+            || !file->map(file_size)) {
+            return std::nullopt;
+        }
+
+        const internal::MappedArrayHeader& header = *file->header();
+
+        if (!is_valid(header, file_size)) {
+            return std::nullopt;
+        }
+
+        if (header.capacity == 0) {
+            return MappedArray(file, array_type(FileAllocator<T>(file)));
+        }
+
+        file->set_in_use(true);
+
+        return MappedArray(
+            file,
+            array_type(
+                adopt_storage,
+                reinterpret_cast<T*>(file->data()),
+                header.size,
+                header.capacity,
+                FileAllocator<T>(file)));
+    }
+
+public:
+    [[nodiscard]] array_type&       items() noexcept { return m_items; }
+    [[nodiscard]] const array_type& items() const noexcept { return m_items; }
+
+    // Records the item count in the file and flushes the mapping to disk.
+    [[nodiscard]] bool sync() noexcept {
+        store_size();
+        return m_file->sync();
+    }
+
+private:
+    void store_size() noexcept { m_file->header()->size = m_items.size(); }
+
+    static void init_header(internal::MappedArrayHeader& header) noexcept {
+        std::memcpy(
+            header.magic,
+            internal::mapped_array_magic,
+            sizeof(internal::mapped_array_magic));
+        header.version    = internal::mapped_array_version;
+        header.item_size  = sizeof(T);
+        header.item_align = alignof(T);
+        header.reserved   = 0;
+        header.size       = 0;
+        header.capacity   = 0;
+    }
+
+    [[nodiscard]] static bool is_valid(
+        const internal::MappedArrayHeader& header, size_t file_size) noexcept {
+        const size_t data_bytes
+            = file_size - internal::mapped_array_data_offset;
+
+        return std::memcmp(
+                   header.magic,
+                   internal::mapped_array_magic,
+                   sizeof(internal::mapped_array_magic))
+                   == 0
+               && header.version == internal::mapped_array_version
+               && header.item_size == sizeof(T)
+               && header.item_align == alignof(T)
+               && header.size <= header.capacity
+               && header.capacity <= data_bytes / sizeof(T);
+    }
+};
+}
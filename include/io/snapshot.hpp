@@ -0,0 +1,358 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../container/dynamic_array.hpp"
+#include "../macro/assert.hpp"
+#include "../memory/external_allocator.hpp"
+
+namespace frank {
+// Describes one column stored in a snapshot file. `archetype` and `component`
+// are opaque ids chosen by the writer and are only used to look columns up
+// again.
+struct SnapshotColumn {
+    std::uint64_t archetype;
+    std::uint64_t component;
+    std::uint64_t offset;
+    std::uint64_t count;
+    std::uint32_t item_size;
+    std::uint32_t item_align;
+};
+
+namespace internal {
+// File layout:
+//
+//   SnapshotHeader
+//   SnapshotColumn[column_count]
+//   column data, every column starting on a snapshot_alignment boundary
+//
+// All integers are stored in host byte order. Column data is the raw object
+// representation of trivially copyable items, so a snapshot can only be read
+// back on a machine with the same ABI.
+struct SnapshotHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t column_count;
+    std::uint64_t file_size;
+};
+
+inline constexpr char snapshot_magic[8]
+    = {'F', 'R', 'A', 'N', 'K', 'S', 'N', 'P'};
+
+inline constexpr std::uint32_t snapshot_version = 1;
+
+inline constexpr std::uint64_t snapshot_alignment = 64;
+
+[[nodiscard]] constexpr std::uint64_t
+align_up(std::uint64_t n, std::uint64_t alignment) noexcept {
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+struct SnapshotPending {
+    SnapshotColumn column;
+    const void*    data;
+};
+}
+
+// Collects columns and writes them into a single snapshot file. The writer
+// only records where the columns live; they must stay alive and unchanged
+// until write() returns.
+class SnapshotWriter {
+private:
+    DynamicArray<internal::SnapshotPending> m_columns;
+
+public:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void add(
+        std::uint64_t      archetype,
+        std::uint64_t      component,
+        std::span<const T> column) {
+        m_columns.push_back(internal::SnapshotPending {
+            .column = {
+                .archetype  = archetype,
+                .component  = component,
+                .offset     = 0,
+                .count      = column.size(),
+                .item_size  = sizeof(T),
+                .item_align = alignof(T),
+            },
+            .data = column.data(),
+        });
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return m_columns.size();
+    }
+
+    // Writes all collected columns to `path`, replacing the file. Returns
+    // false if the file could not be written.
+    [[nodiscard]] bool write(const char* path) {
+        std::uint64_t offset = internal::align_up(
+            sizeof(internal::SnapshotHeader)
+                + m_columns.size() * sizeof(SnapshotColumn),
+            internal::snapshot_alignment);
+
+        for (internal::SnapshotPending& pending : m_columns) {
+            pending.column.offset = offset;
+            offset                = internal::align_up(
+                offset + pending.column.count * pending.column.item_size,
+                internal::snapshot_alignment);
+        }
+
+        internal::SnapshotHeader header {};
+        std::memcpy(
+            header.magic,
+            internal::snapshot_magic,
+            sizeof(internal::snapshot_magic));
+        header.version      = internal::snapshot_version;
+        header.column_count = static_cast<std::uint32_t>(m_columns.size());
+        header.file_size    = offset;
+
+        std::FILE* file = std::fopen(path, "wb");
+        if (file == nullptr) {
+            return false;
+        }
+
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+        for (const internal::SnapshotPending& pending : m_columns) {
+            ok = ok
+                 && std::fwrite(
+                        &pending.column, sizeof(SnapshotColumn), 1, file)
+                        == 1;
+        }
+
+        for (const internal::SnapshotPending& pending : m_columns) {
+            const size_t bytes
+                = pending.column.count * pending.column.item_size;
+
+            ok = ok && pad_to(file, pending.column.offset);
+            ok = ok
+                 && (bytes == 0
+                     || std::fwrite(pending.data, bytes, 1, file) == 1);
+        }
+
+        ok = ok && pad_to(file, offset);
+
+        return std::fclose(file) == 0 && ok;
+    }
+
+private:
+    static bool pad_to(std::FILE* file, std::uint64_t offset) {
+        static constexpr char zeros[internal::snapshot_alignment] {};
+
+        const long pos = std::ftell(file);
+        if (pos < 0 || static_cast<std::uint64_t>(pos) > offset) {
+            return false;
+        }
+
+        const size_t padding = offset - static_cast<std::uint64_t>(pos);
+        return padding == 0 || std::fwrite(zeros, padding, 1, file) == 1;
+    }
+};
+
+// A snapshot file mapped into memory. Columns are never parsed or copied:
+// view() points straight into the mapping and load() hands the mapped bytes
+// to a DynamicArray. The mapping is private, so writes through a loaded
+// column copy the touched pages and never reach the file.
+//
+// A column should be loaded at most once per Snapshot, every load of the same
+// column shares the same memory.
+class Snapshot {
+private:
+    struct Mapping {
+        void*  base {nullptr};
+        size_t size {0};
+
+        ~Mapping() {
+            if (base != nullptr) {
+                ::munmap(base, size);
+            }
+        }
+    };
+
+    std::shared_ptr<Mapping> m_mapping;
+    const SnapshotColumn*    m_columns {nullptr};
+    size_t                   m_column_count {0};
+
+    Snapshot() = default;
+
+public:
+    // Maps the snapshot at `path`. Returns std::nullopt if the file cannot be
+    // opened or is not a valid snapshot.
+    [[nodiscard]] static std::optional<Snapshot> open(const char* path) {
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0
+            || static_cast<size_t>(st.st_size)
+                   < sizeof(internal::SnapshotHeader)) {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        void* base = ::mmap(
+            nullptr,
+            static_cast<size_t>(st.st_size),
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE,
+            fd,
+            0);
+        ::close(fd);
+
+        if (base == MAP_FAILED) {
+            return std::nullopt;
+        }
+
+        Snapshot snapshot;
+        snapshot.m_mapping       = std::make_shared<Mapping>();
+        snapshot.m_mapping->base = base;
+        snapshot.m_mapping->size = static_cast<size_t>(st.st_size);
+
+        if (!snapshot.validate()) {
+            return std::nullopt;
+        }
+
+        return snapshot;
+    }
+
+public:
+    [[nodiscard]] size_t column_count() const noexcept {
+        return m_column_count;
+    }
+
+    [[nodiscard]] const SnapshotColumn& column(size_t idx) const noexcept {
+        FRANK_ASSERT(idx < m_column_count);
+        return m_columns[idx];
+    }
+
+    [[nodiscard]] std::optional<size_t> find(
+        std::uint64_t archetype, std::uint64_t component) const noexcept {
+        for (size_t i = 0; i < m_column_count; ++i) {
+            if (m_columns[i].archetype == archetype
+                && m_columns[i].component == component) {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // Returns the column as a span into the mapping, or std::nullopt if the
+    // stored item layout does not match T.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] std::optional<std::span<T>> view(size_t idx) const noexcept {
+        if (!matches<T>(idx)) {
+            return std::nullopt;
+        }
+
+        return std::span<T>(items<T>(idx), m_columns[idx].count);
+    }
+
+    // Returns the column as a DynamicArray that adopts the mapped bytes. The
+    // array keeps the mapping alive and only allocates once it grows past the
+    // stored item count.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] std::optional<DynamicArray<T, ExternalAllocator<T>>>
+    load(size_t idx) const {
+        if (!matches<T>(idx)) {
+            return std::nullopt;
+        }
+
+        const size_t count = m_columns[idx].count;
+        if (count == 0) {
+            return DynamicArray<T, ExternalAllocator<T>>();
+        }
+
+        T* first = items<T>(idx);
+
+        return DynamicArray<T, ExternalAllocator<T>>(
+            adopt_storage,
+            first,
+            count,
+            count,
+            ExternalAllocator<T>(m_mapping, first, count * sizeof(T)));
+    }
+
+private:
+    [[nodiscard]] std::byte* bytes() const noexcept {
+        return static_cast<std::byte*>(m_mapping->base);
+    }
+
+    template <typename T>
+    [[nodiscard]] T* items(size_t idx) const noexcept {
+        return reinterpret_cast<T*>(bytes() + m_columns[idx].offset);
+    }
+
+    template <typename T>
+    [[nodiscard]] bool matches(size_t idx) const noexcept {
+        FRANK_ASSERT(idx < m_column_count);
+
+        return m_columns[idx].item_size == sizeof(T)
+               && m_columns[idx].item_align == alignof(T);
+    }
+
+    [[nodiscard]] bool validate() noexcept {
+        const size_t size = m_mapping->size;
+
+        internal::SnapshotHeader header;
+        std::memcpy(&header, bytes(), sizeof(header));
+
+        if (std::memcmp(
+                header.magic,
+                internal::snapshot_magic,
+                sizeof(internal::snapshot_magic))
+                != 0
+            || header.version != internal::snapshot_version
+            || header.file_size != size) {
+            return false;
+        }
+
+        const size_t table = sizeof(internal::SnapshotHeader)
+                             + header.column_count * sizeof(SnapshotColumn);
+        if (table > size) {
+            return false;
+        }
+
+        m_columns = reinterpret_cast<const SnapshotColumn*>(
+            bytes() + sizeof(internal::SnapshotHeader));
+        m_column_count = header.column_count;
+
+        for (size_t i = 0; i < m_column_count; ++i) {
+            const SnapshotColumn& c = m_columns[i];
+
+            if (c.item_size == 0 || c.item_align == 0
+                || c.offset % c.item_align != 0 || c.offset < table
+                || c.offset > size
+                || c.count > (size - c.offset) / c.item_size) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+}
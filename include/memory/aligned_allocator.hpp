@@ -0,0 +1,88 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace frank {
+// Result of allocate_at_least: the block and the number of items it can
+// actually hold.
+template <typename Pointer>
+struct AllocationResult {
+    Pointer ptr;
+    size_t  count;
+};
+
+// Hands out blocks that start on an `Alignment` byte boundary and whose size
+// is a whole multiple of `Alignment`. With DynamicArray the padding shows up
+// as extra capacity (through allocate_at_least), so data() is aligned for
+// vector loads, the usable length can be rounded up to a full vector without
+// a scalar tail, and two arrays never share a cache line.
+template <typename T, size_t Alignment = 64>
+    requires(std::has_single_bit(Alignment) && Alignment >= alignof(T))
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    static constexpr size_t alignment = Alignment;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr AlignedAllocator(
+        const AlignedAllocator<U, Alignment>&) noexcept { }
+
+    template <typename U>
+    constexpr bool
+    operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+        return true;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) { return allocate_at_least(n).ptr; }
+
+    [[nodiscard]] AllocationResult<T*> allocate_at_least(size_t n) {
+        const size_t bytes = padded_bytes(n);
+
+        void* p = ::operator new(bytes, std::align_val_t(Alignment));
+
+        return AllocationResult<T*> {
+            .ptr   = static_cast<T*>(p),
+            .count = bytes / sizeof(T),
+        };
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(static_cast<void*>(p), std::align_val_t(Alignment));
+    }
+
+    [[nodiscard]] constexpr size_t max_size() const noexcept {
+        return (std::numeric_limits<size_t>::max() - Alignment) / sizeof(T);
+    }
+
+private:
+    [[nodiscard]] static size_t padded_bytes(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - Alignment) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        return (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+    }
+};
+}
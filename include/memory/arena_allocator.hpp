@@ -0,0 +1,249 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../macro/assert.hpp"
+
+namespace frank {
+inline constexpr size_t arena_default_chunk_bytes = size_t {1} << 16;
+
+// A bump pointer arena. Allocating moves a cursor through the current chunk;
+// when it runs out a new chunk, twice as large as the last one, is linked
+// behind it. Nothing is freed individually. reset() rewinds the cursor to the
+// first chunk in O(1) and keeps every chunk for reuse, so after a warm-up
+// frame a frame arena stops calling into the heap at all.
+//
+// Everything allocated from the arena must be dead before reset() or before
+// the arena is destroyed. Not thread safe.
+class Arena {
+private:
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+        size_t size;
+
+        [[nodiscard]] std::byte* data() noexcept {
+            return reinterpret_cast<std::byte*>(this + 1);
+        }
+    };
+
+    Chunk*     m_first {nullptr};
+    Chunk*     m_current {nullptr};
+    std::byte* m_cursor {nullptr};
+    std::byte* m_end {nullptr};
+    std::byte* m_last {nullptr};
+    size_t     m_chunk_bytes;
+    size_t     m_chunk_count {0};
+
+public:
+    ~Arena() noexcept { release(); }
+
+    explicit Arena(size_t chunk_bytes = arena_default_chunk_bytes) noexcept
+        : m_chunk_bytes(std::max<size_t>(chunk_bytes, 64)) { }
+
+    Arena(const Arena&) = delete;
+    Arena(Arena&&)      = delete;
+
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&&)      = delete;
+
+public:
+    [[nodiscard]] void* allocate(size_t bytes, size_t align) {
+        FRANK_ASSERT(align != 0 && (align & (align - 1)) == 0);
+
+        std::byte* p = align_up(m_cursor, align);
+
+        // Aligning can step past the end of the chunk, so check that before
+        // measuring what is left.
+        if (m_cursor == nullptr || p > m_end
+            || bytes > static_cast<size_t>(m_end - p)) {
+            next_chunk(bytes, align);
+            p = align_up(m_cursor, align);
+        }
+
+        m_last   = p;
+        m_cursor = p + bytes;
+
+        return p;
+    }
+
+    // Resizes the block at `p` of `old_bytes`. The most recent allocation is
+    // resized in place when it fits; anything else is copied to a new block.
+    [[nodiscard]] void*
+    reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t align) {
+        std::byte* b = static_cast<std::byte*>(p);
+
+        if (b == m_last && b <= m_end
+            && new_bytes <= static_cast<size_t>(m_end - b)) {
+            m_cursor = b + new_bytes;
+            return p;
+        }
+
+        void* q = allocate(new_bytes, align);
+        std::memcpy(q, p, std::min(old_bytes, new_bytes));
+
+        return q;
+    }
+
+    // Forgets every allocation but keeps the chunks. O(1).
+    void reset() noexcept {
+        m_current = m_first;
+        m_cursor  = m_first == nullptr ? nullptr : m_first->data();
+        m_end     = m_first == nullptr ? nullptr : m_cursor + m_first->size;
+        m_last    = nullptr;
+    }
+
+    // Like reset(), but also returns every chunk to the heap.
+    void release() noexcept {
+        while (m_first != nullptr) {
+            Chunk* next = m_first->next;
+            ::operator delete(static_cast<void*>(m_first));
+            m_first = next;
+        }
+
+        m_chunk_count = 0;
+        reset();
+    }
+
+    [[nodiscard]] size_t chunk_count() const noexcept { return m_chunk_count; }
+
+    // Bytes left in the current chunk.
+    [[nodiscard]] size_t remaining() const noexcept {
+        return static_cast<size_t>(m_end - m_cursor);
+    }
+
+private:
+    [[nodiscard]] static std::byte*
+    align_up(std::byte* p, size_t align) noexcept {
+        const uintptr_t a = reinterpret_cast<uintptr_t>(p);
+        return p + ((align - a % align) % align);
+    }
+
+    // Moves on to the first chunk after the current one that can hold the
+    // request, linking a new chunk at the end when none can.
+    void next_chunk(size_t bytes, size_t align) {
+        const size_t need = bytes + align;
+
+        Chunk* chunk = m_current == nullptr ? m_first : m_current->next;
+        Chunk* tail  = m_current;
+
+        for (; chunk != nullptr; chunk = chunk->next) {
+            if (chunk->size >= need) {
+                break;
+            }
+
+            tail = chunk;
+        }
+
+        if (chunk == nullptr) {
+            chunk = allocate_chunk(need);
+
+            if (tail == nullptr) {
+                m_first = chunk;
+            } else {
+                while (tail->next != nullptr) {
+                    tail = tail->next;
+                }
+
+                tail->next = chunk;
+            }
+        }
+
+        m_current = chunk;
+        m_cursor  = chunk->data();
+        m_end     = m_cursor + chunk->size;
+    }
+
+    [[nodiscard]] Chunk* allocate_chunk(size_t need) {
+        if (need > std::numeric_limits<size_t>::max() / 2 - sizeof(Chunk)) {
+            throw std::bad_alloc();
+        }
+
+        // Doubling stops at 2^16 times the first chunk.
+        const size_t size = std::max(
+            need, m_chunk_bytes << std::min<size_t>(m_chunk_count, 16));
+
+        Chunk* chunk
+            = static_cast<Chunk*>(::operator new(sizeof(Chunk) + size));
+        chunk->next = nullptr;
+        chunk->size = size;
+        ++m_chunk_count;
+
+        return chunk;
+    }
+};
+
+// An allocator over an Arena, usable with DynamicArray, List and the other
+// containers. deallocate() does nothing; memory comes back all at once when
+// the arena is reset. reallocate() grows the newest block in place, which
+// covers the common case of one DynamicArray growing at the top of the arena.
+//
+// Copies and rebinds refer to the same arena.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena* m_arena;
+
+public:
+    ArenaAllocator(Arena& arena) noexcept
+        : m_arena(&arena) { }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : m_arena(other.m_arena) { }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return m_arena == other.m_arena;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) {
+        return static_cast<T*>(m_arena->allocate(to_bytes(n), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept { }
+
+    // Bytewise, like MallocAllocator::reallocate(). DynamicArray only calls
+    // it for trivially relocatable items.
+    [[nodiscard]] T* reallocate(T* p, size_t old_n, size_t new_n) {
+        return static_cast<T*>(m_arena->reallocate(
+            static_cast<void*>(p),
+            old_n * sizeof(T),
+            to_bytes(new_n),
+            alignof(T)));
+    }
+
+    [[nodiscard]] Arena& arena() const noexcept { return *m_arena; }
+
+private:
+    [[nodiscard]] static size_t to_bytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        return n * sizeof(T);
+    }
+};
+}
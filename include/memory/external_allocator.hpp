@@ -0,0 +1,85 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace frank {
+// An allocator for containers that start out on memory they do not own, such
+// as a memory mapped file. Blocks inside the external range are never freed
+// by the allocator; they stay alive for as long as any copy of the allocator
+// holds `owner`. Everything allocated later (for example when the container
+// grows) comes from the global heap and is freed normally.
+//
+// Meant to be used together with DynamicArray's adopt_storage constructor.
+template <typename T>
+class ExternalAllocator {
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+private:
+    template <typename U>
+    friend class ExternalAllocator;
+
+    std::shared_ptr<const void> m_owner;
+    const std::byte*            m_begin {nullptr};
+    const std::byte*            m_end {nullptr};
+
+public:
+    ~ExternalAllocator() = default;
+
+    ExternalAllocator() noexcept = default;
+
+    ExternalAllocator(
+        std::shared_ptr<const void> owner,
+        const void*                 begin,
+        size_t                      bytes) noexcept
+        : m_owner(std::move(owner))
+        , m_begin(static_cast<const std::byte*>(begin))
+        , m_end(static_cast<const std::byte*>(begin) + bytes) { }
+
+    template <typename U>
+    ExternalAllocator(const ExternalAllocator<U>& other) noexcept
+        : m_owner(other.m_owner)
+        , m_begin(other.m_begin)
+        , m_end(other.m_end) { }
+
+    ExternalAllocator(const ExternalAllocator&) noexcept = default;
+    ExternalAllocator(ExternalAllocator&&) noexcept      = default;
+
+    ExternalAllocator& operator=(const ExternalAllocator&) noexcept = default;
+    ExternalAllocator& operator=(ExternalAllocator&&) noexcept      = default;
+
+    template <typename U>
+    bool operator==(const ExternalAllocator<U>& other) const noexcept {
+        return m_begin == other.m_begin && m_end == other.m_end;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (owns(p)) {
+            return;
+        }
+
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    [[nodiscard]] bool owns(const void* p) const noexcept {
+        const std::byte* b = static_cast<const std::byte*>(p);
+        return m_begin != nullptr && b >= m_begin && b < m_end;
+    }
+};
+}
@@ -0,0 +1,255 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+#include "aligned_allocator.hpp"
+
+namespace frank {
+inline constexpr size_t huge_page_size = size_t {1} << 21;
+
+// Blocks of at least this many bytes are backed by transparent huge pages.
+inline constexpr size_t huge_page_allocator_threshold = huge_page_size;
+
+// An allocator for large columns. Blocks of `Threshold` bytes or more get a
+// private anonymous mapping whose start and length are multiples of 2 MiB and
+// are marked with madvise(MADV_HUGEPAGE), so the kernel can back them with
+// huge pages and a full scan touches one TLB entry per 2 MiB instead of per
+// 4 KiB. Smaller blocks come from the global heap.
+//
+// allocate_at_least() reports the rounded up length, so a DynamicArray uses
+// the whole last huge page as capacity. reallocate() moves mapped blocks with
+// mremap onto a fresh aligned range, which keeps the huge page alignment and
+// moves page table entries instead of copying the bytes.
+//
+// Like MallocAllocator, whether a block is mapped is decided by its size in
+// bytes alone.
+template <typename T, size_t Threshold = huge_page_allocator_threshold>
+class HugePageAllocator {
+    static_assert(
+        alignof(T) <= alignof(std::max_align_t),
+        "HugePageAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, Threshold>;
+    };
+
+    constexpr HugePageAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr HugePageAllocator(
+        const HugePageAllocator<U, Threshold>&) noexcept { }
+
+    template <typename U>
+    constexpr bool
+    operator==(const HugePageAllocator<U, Threshold>&) const noexcept {
+        return true;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) { return allocate_at_least(n).ptr; }
+
+    [[nodiscard]] AllocationResult<T*> allocate_at_least(size_t n) {
+        const size_t bytes = to_bytes(n);
+
+        if (!is_mapped(bytes)) {
+            return AllocationResult<T*> {
+                .ptr   = std::allocator<T>().allocate(n),
+                .count = n,
+            };
+        }
+
+        const size_t len = huge_round(bytes);
+
+        void* p = map_aligned(len);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return AllocationResult<T*> {
+            .ptr   = static_cast<T*>(p),
+            .count = len / sizeof(T),
+        };
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+
+        if (is_mapped(bytes)) {
+            ::munmap(static_cast<void*>(p), huge_round(bytes));
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    // Resizes the block at `p` from `old_n` to `new_n` items and returns its
+    // new address. The first min(old_n, new_n) items are preserved bytewise.
+    [[nodiscard]] T* reallocate(T* p, size_t old_n, size_t new_n) {
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = to_bytes(new_n);
+
+        if (is_mapped(old_bytes) && is_mapped(new_bytes)) {
+            void* q = remap(
+                static_cast<void*>(p),
+                huge_round(old_bytes),
+                huge_round(new_bytes));
+
+            if (q == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T*>(q);
+        }
+
+        T* fresh = allocate(new_n);
+        std::memcpy(
+            static_cast<void*>(fresh),
+            static_cast<const void*>(p),
+            std::min(old_bytes, new_bytes));
+        deallocate(p, old_n);
+
+        return fresh;
+    }
+
+    [[nodiscard]] constexpr size_t max_size() const noexcept {
+        return (std::numeric_limits<size_t>::max() - huge_page_size)
+               / sizeof(T);
+    }
+
+private:
+    [[nodiscard]] static size_t to_bytes(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - huge_page_size)
+                    / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        return n * sizeof(T);
+    }
+
+    [[nodiscard]] static constexpr bool is_mapped(size_t bytes) noexcept {
+        return bytes >= Threshold;
+    }
+
+    [[nodiscard]] static constexpr size_t huge_round(size_t bytes) noexcept {
+        return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+    }
+
+    static void advise(void* p, size_t len) noexcept {
+#if defined(MADV_HUGEPAGE)
+        // Only a hint; without THP support the mapping simply keeps using
+        // regular pages.
+        ::madvise(p, len, MADV_HUGEPAGE);
+#else
+        (void)p;
+        (void)len;
+#endif
+    }
+
+    // Maps `len` bytes starting on a huge page boundary by over-mapping one
+    // huge page and trimming the unaligned head and tail.
+    [[nodiscard]] static void* map_aligned(size_t len) noexcept {
+        const size_t span = len + huge_page_size;
+
+        void* raw = ::mmap(
+            nullptr,
+            span,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS,
+            -1,
+            0);
+
+        if (raw == MAP_FAILED) {
+            return nullptr;
+        }
+
+        const uintptr_t begin   = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (begin + huge_page_size - 1)
+                                  / huge_page_size * huge_page_size;
+        const size_t head = aligned - begin;
+        const size_t tail = span - head - len;
+
+        if (head != 0) {
+            ::munmap(raw, head);
+        }
+
+        if (tail != 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + len), tail);
+        }
+
+        void* p = reinterpret_cast<void*>(aligned);
+        advise(p, len);
+
+        return p;
+    }
+
+    [[nodiscard]] static void*
+    remap(void* p, size_t old_len, size_t new_len) noexcept {
+        if (old_len == new_len) {
+            return p;
+        }
+
+        std::byte* b = static_cast<std::byte*>(p);
+
+        if (new_len < old_len) {
+            ::munmap(b + new_len, old_len - new_len);
+            return p;
+        }
+
+#if defined(__linux__)
+        // Try to grow in place first, then move the pages onto a new aligned
+        // range. MREMAP_FIXED replaces the placeholder mapping at `q`.
+        void* q = ::mremap(p, old_len, new_len, 0);
+        if (q != MAP_FAILED) {
+            advise(q, new_len);
+            return q;
+        }
+
+        q = map_aligned(new_len);
+        if (q == nullptr) {
+            return nullptr;
+        }
+
+        void* moved = ::mremap(
+            p, old_len, new_len, MREMAP_MAYMOVE | MREMAP_FIXED, q);
+        if (moved == MAP_FAILED) {
+            ::munmap(q, new_len);
+            return nullptr;
+        }
+
+        advise(moved, new_len);
+        return moved;
+#else
+        void* q = map_aligned(new_len);
+        if (q == nullptr) {
+            return nullptr;
+        }
+
+        std::memcpy(q, p, old_len);
+        ::munmap(p, old_len);
+
+        return q;
+#endif
+    }
+};
+}
@@ -0,0 +1,179 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../macro/assert.hpp"
+
+namespace frank {
+// Blocks of at least this many bytes are mapped directly from the kernel
+// instead of coming from malloc, so they can later be resized with mremap.
+inline constexpr size_t malloc_allocator_map_threshold = size_t {1} << 25;
+
+// An allocator over malloc/realloc/free that also offers reallocate(). For
+// trivially copyable items DynamicArray grows through reallocate(), which
+// lets malloc extend the block in place where it can. Blocks above
+// `MapThreshold` bytes live in their own mapping and are resized with mremap,
+// which moves page table entries instead of copying the bytes and never needs
+// the old and new block to exist side by side.
+//
+// Whether a block is mapped is decided purely by its size in bytes, so
+// deallocate() and reallocate() can tell the two kinds apart from the item
+// count alone.
+template <typename T, size_t MapThreshold = malloc_allocator_map_threshold>
+class MallocAllocator {
+    static_assert(
+        alignof(T) <= alignof(std::max_align_t),
+        "MallocAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = MallocAllocator<U, MapThreshold>;
+    };
+
+    constexpr MallocAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr MallocAllocator(
+        const MallocAllocator<U, MapThreshold>&) noexcept { }
+
+    template <typename U>
+    constexpr bool
+    operator==(const MallocAllocator<U, MapThreshold>&) const noexcept {
+        return true;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) {
+        const size_t bytes = to_bytes(n);
+
+        void* p = is_mapped(bytes) ? map(bytes) : std::malloc(bytes);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+
+        if (is_mapped(bytes)) {
+            ::munmap(static_cast<void*>(p), page_round(bytes));
+        } else {
+            std::free(static_cast<void*>(p));
+        }
+    }
+
+    // Resizes the block at `p` from `old_n` to `new_n` items and returns its
+    // new address. The first min(old_n, new_n) items are preserved bytewise.
+    [[nodiscard]] T* reallocate(T* p, size_t old_n, size_t new_n) {
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = to_bytes(new_n);
+
+        void* q = nullptr;
+
+        if (!is_mapped(old_bytes) && !is_mapped(new_bytes)) {
+            q = std::realloc(static_cast<void*>(p), new_bytes);
+        } else if (is_mapped(old_bytes) && is_mapped(new_bytes)) {
+            q = remap(static_cast<void*>(p), old_bytes, new_bytes);
+        } else {
+            T* fresh = allocate(new_n);
+            std::memcpy(
+                static_cast<void*>(fresh),
+                static_cast<const void*>(p),
+                std::min(old_bytes, new_bytes));
+            deallocate(p, old_n);
+
+            return fresh;
+        }
+
+        if (q == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(q);
+    }
+
+    [[nodiscard]] constexpr size_t max_size() const noexcept {
+        return std::numeric_limits<size_t>::max() / sizeof(T);
+    }
+
+private:
+    [[nodiscard]] static size_t to_bytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        return n * sizeof(T);
+    }
+
+    [[nodiscard]] static constexpr bool is_mapped(size_t bytes) noexcept {
+        return bytes >= MapThreshold;
+    }
+
+    [[nodiscard]] static size_t page_round(size_t bytes) noexcept {
+        static const size_t page
+            = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+        return (bytes + page - 1) / page * page;
+    }
+
+    [[nodiscard]] static void* map(size_t bytes) noexcept {
+        void* p = ::mmap(
+            nullptr,
+            page_round(bytes),
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS,
+            -1,
+            0);
+
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    [[nodiscard]] static void*
+    remap(void* p, size_t old_bytes, size_t new_bytes) noexcept {
+        const size_t old_len = page_round(old_bytes);
+        const size_t new_len = page_round(new_bytes);
+
+        if (old_len == new_len) {
+            return p;
+        }
+
+#if defined(__linux__)
+        void* q = ::mremap(p, old_len, new_len, MREMAP_MAYMOVE);
+        return q == MAP_FAILED ? nullptr : q;
+#else
+        void* q = map(new_bytes);
+        if (q == nullptr) {
+            return nullptr;
+        }
+
+        std::memcpy(q, p, std::min(old_len, new_len));
+        ::munmap(p, old_len);
+
+        return q;
+#endif
+    }
+};
+}
@@ -0,0 +1,81 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "arena_allocator.hpp"
+#include "tracking_allocator.hpp"
+
+namespace frank {
+namespace pmr {
+// A std::pmr::memory_resource over an Arena. Like ArenaAllocator, freeing
+// does nothing and the memory comes back when the arena is reset.
+class ArenaResource : public std::pmr::memory_resource {
+private:
+    Arena* m_arena;
+
+public:
+    explicit ArenaResource(Arena& arena) noexcept
+        : m_arena(&arena) { }
+
+    [[nodiscard]] Arena& arena() const noexcept { return *m_arena; }
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        return m_arena->allocate(bytes, align);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override { }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        const ArenaResource* arena = dynamic_cast<const ArenaResource*>(&other);
+        return arena != nullptr && arena->m_arena == m_arena;
+    }
+};
+
+// Forwards to `upstream` and records every allocation in an AllocationStats,
+// the memory_resource counterpart of TrackingAllocator.
+class TrackingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* m_upstream;
+    AllocationStats*           m_stats;
+
+public:
+    TrackingResource(
+        AllocationStats&           stats,
+        std::pmr::memory_resource* upstream
+        = std::pmr::get_default_resource()) noexcept
+        : m_upstream(upstream)
+        , m_stats(&stats) { }
+
+    [[nodiscard]] AllocationStats& stats() const noexcept { return *m_stats; }
+
+    [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept {
+        return m_upstream;
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        void* p = m_upstream->allocate(bytes, align);
+        m_stats->record_allocate(bytes);
+
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        m_stats->record_deallocate(bytes);
+        m_upstream->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+}
+}
@@ -0,0 +1,255 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace frank {
+namespace internal {
+// Fixed size slots carved out of blocks of `block_items` slots each. Fresh
+// slots are handed out by bumping through the newest block; freed slots go on
+// a free list threaded through the slots themselves. Blocks are only returned
+// when the pool is destroyed.
+class NodePool {
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    // Slots follow the header, starting at the first multiple of the slot
+    // alignment.
+    struct Block {
+        Block* next;
+    };
+
+    Block*     m_blocks {nullptr};
+    FreeSlot*  m_free {nullptr};
+    std::byte* m_fresh {nullptr};
+    std::byte* m_fresh_end {nullptr};
+    size_t     m_slot_size;
+    size_t     m_slot_align;
+    size_t     m_block_items;
+    size_t     m_block_count {0};
+
+public:
+    ~NodePool() noexcept {
+        while (m_blocks != nullptr) {
+            Block* next = m_blocks->next;
+            ::operator delete(
+                static_cast<void*>(m_blocks), std::align_val_t(block_align()));
+            m_blocks = next;
+        }
+    }
+
+    NodePool(size_t slot_size, size_t slot_align, size_t block_items) noexcept
+        : m_slot_align(std::max(slot_align, alignof(FreeSlot)))
+        , m_block_items(block_items) {
+        m_slot_size = round_up(std::max(slot_size, sizeof(FreeSlot)));
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool(NodePool&&)      = delete;
+
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool& operator=(NodePool&&)      = delete;
+
+public:
+    [[nodiscard]] void* allocate() {
+        if (m_free != nullptr) {
+            FreeSlot* slot = m_free;
+            m_free         = slot->next;
+
+            return slot;
+        }
+
+        if (m_fresh == m_fresh_end) {
+            allocate_block();
+        }
+
+        void* p = m_fresh;
+        m_fresh += m_slot_size;
+
+        return p;
+    }
+
+    void deallocate(void* p) noexcept {
+        FreeSlot* slot = static_cast<FreeSlot*>(p);
+        slot->next     = m_free;
+        m_free         = slot;
+    }
+
+    // Whether the pool serves items of `size` bytes aligned to `align`.
+    [[nodiscard]] bool serves(size_t size, size_t align) const noexcept {
+        return round_up(std::max(size, sizeof(FreeSlot))) == m_slot_size
+               && std::max(align, alignof(FreeSlot)) == m_slot_align;
+    }
+
+    [[nodiscard]] size_t slot_size() const noexcept { return m_slot_size; }
+
+    [[nodiscard]] size_t block_count() const noexcept { return m_block_count; }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return m_block_count * m_block_items;
+    }
+
+private:
+    [[nodiscard]] size_t round_up(size_t bytes) const noexcept {
+        return (bytes + m_slot_align - 1) / m_slot_align * m_slot_align;
+    }
+
+    [[nodiscard]] size_t block_align() const noexcept {
+        return std::max(m_slot_align, alignof(Block));
+    }
+
+    void allocate_block() {
+        const size_t header = round_up(sizeof(Block));
+
+        std::byte* raw = static_cast<std::byte*>(::operator new(
+            header + m_slot_size * m_block_items,
+            std::align_val_t(block_align())));
+
+        Block* block = reinterpret_cast<Block*>(raw);
+        block->next  = m_blocks;
+        m_blocks     = block;
+        m_fresh      = raw + header;
+        m_fresh_end  = m_fresh + m_slot_size * m_block_items;
+        ++m_block_count;
+    }
+};
+
+// The pools shared by a PoolAllocator and everything rebound from it, one per
+// slot layout. Items of the same size and alignment share a pool whatever
+// their type. Not thread safe, like the pools themselves.
+class NodePools {
+private:
+    std::vector<std::unique_ptr<NodePool>> m_pools;
+    size_t                                 m_block_items;
+
+public:
+    explicit NodePools(size_t block_items) noexcept
+        : m_block_items(block_items) { }
+
+    [[nodiscard]] NodePool& get(size_t size, size_t align) {
+        for (const std::unique_ptr<NodePool>& pool : m_pools) {
+            if (pool->serves(size, align)) {
+                return *pool;
+            }
+        }
+
+        return *m_pools.emplace_back(
+            std::make_unique<NodePool>(size, align, m_block_items));
+    }
+};
+}
+
+// Allocates single items from a shared NodePool instead of the heap, which
+// turns node allocation in List into a pointer bump or a free list pop and
+// keeps neighbouring nodes in the same block. Requests for more than one item
+// fall through to the global heap.
+//
+// Copies and rebinds of an allocator share its pools, so equal allocators
+// can free each other's nodes (List::splice relies on this) and a rebound
+// allocator converts back to one equal to the original. The pools live until
+// the last allocator referring to them is gone and then release all of their
+// blocks at once. That includes every copy handed out, such as the one
+// List::allocator() returns, so a list's blocks outlive the list while any
+// copy of its allocator does. Copying a container gives the copy pools of its
+// own.
+template <typename T, size_t BlockItems = 256>
+    requires(BlockItems != 0)
+class PoolAllocator {
+public:
+    using value_type = T;
+    using pool_type  = internal::NodePool;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    static constexpr size_t block_items = BlockItems;
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, BlockItems>;
+    };
+
+private:
+    template <typename U, size_t B>
+        requires(B != 0)
+    friend class PoolAllocator;
+
+    std::shared_ptr<internal::NodePools> m_pools;
+    pool_type*                           m_pool;
+
+public:
+    ~PoolAllocator() = default;
+
+    PoolAllocator()
+        : m_pools(std::make_shared<internal::NodePools>(BlockItems))
+        , m_pool(&m_pools->get(sizeof(T), alignof(T))) { }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U, BlockItems>& other)
+        : m_pools(other.m_pools)
+        , m_pool(&m_pools->get(sizeof(T), alignof(T))) { }
+
+    // No move constructor on purpose; a moved-from container keeps a usable
+    // allocator that still compares equal to the moved one.
+    PoolAllocator(const PoolAllocator&) noexcept = default;
+
+    PoolAllocator& operator=(const PoolAllocator&) noexcept = default;
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U, BlockItems>& other) const noexcept {
+        return m_pools == other.m_pools;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(m_pool->allocate());
+        }
+
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (n == 1) {
+            m_pool->deallocate(static_cast<void*>(p));
+            return;
+        }
+
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    [[nodiscard]] PoolAllocator
+    select_on_container_copy_construction() const {
+        return PoolAllocator();
+    }
+
+    [[nodiscard]] const pool_type& pool() const noexcept { return *m_pool; }
+
+    // Whether no other allocator refers to the pools, so they go away with
+    // this one.
+    [[nodiscard]] bool is_sole_owner() const noexcept {
+        return m_pools.use_count() == 1;
+    }
+};
+
+namespace internal {
+template <typename Allocator>
+inline constexpr bool is_pool_allocator_v = false;
+
+template <typename T, size_t BlockItems>
+inline constexpr bool is_pool_allocator_v<PoolAllocator<T, BlockItems>> = true;
+}
+}
@@ -0,0 +1,337 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "../macro/assert.hpp"
+#include "aligned_allocator.hpp"
+
+namespace frank {
+namespace internal {
+// Power of two size classes from 16 B to 1 MiB. Larger blocks bypass the
+// caches and go straight to the global heap.
+inline constexpr size_t size_class_min_shift = 4;
+inline constexpr size_t size_class_max_shift = 20;
+inline constexpr size_t size_class_count
+    = size_class_max_shift - size_class_min_shift + 1;
+
+inline constexpr size_t size_class_max_bytes = size_t {1}
+                                               << size_class_max_shift;
+
+[[nodiscard]] inline constexpr size_t size_class_of(size_t bytes) noexcept {
+    const size_t shift = std::bit_width(std::max<size_t>(bytes, 1) - 1);
+    return std::max(shift, size_class_min_shift) - size_class_min_shift;
+}
+
+[[nodiscard]] inline constexpr size_t size_class_bytes(size_t cls) noexcept {
+    return size_t {1} << (cls + size_class_min_shift);
+}
+
+// Blocks moved between a thread cache and the shared heap at a time: about
+// 64 KiB worth, between 1 and 32 blocks.
+[[nodiscard]] inline constexpr size_t size_class_batch(size_t cls) noexcept {
+    return std::clamp<size_t>(
+        (size_t {1} << 16) / size_class_bytes(cls), 1, 32);
+}
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+// The process wide pool behind the thread caches. One locked free list per
+// size class; threads only come here once per batch. Memory is carved from
+// slabs that are never returned, and the heap itself is never destroyed so
+// containers with static storage can still free into it at exit.
+class SizeClassHeap {
+private:
+    struct Class {
+        std::mutex mutex;
+        FreeBlock* head {nullptr};
+    };
+
+    Class m_classes[size_class_count];
+
+public:
+    [[nodiscard]] static SizeClassHeap& instance() {
+        static SizeClassHeap* heap = new SizeClassHeap();
+        return *heap;
+    }
+
+    // Takes up to one batch of blocks of class `cls`, carving a new slab when
+    // the class is empty. Returns the number of blocks in `first`.
+    [[nodiscard]] size_t take_batch(size_t cls, FreeBlock*& first) {
+        const size_t batch = size_class_batch(cls);
+        Class&       c     = m_classes[cls];
+
+        {
+            std::lock_guard lock(c.mutex);
+
+            if (c.head != nullptr) {
+                first         = c.head;
+                FreeBlock* it = c.head;
+                size_t     n  = 1;
+
+                for (; n < batch && it->next != nullptr; ++n) {
+                    it = it->next;
+                }
+
+                c.head   = it->next;
+                it->next = nullptr;
+
+                return n;
+            }
+        }
+
+        first = carve_slab(cls, batch);
+        return batch;
+    }
+
+    // Returns the chain [first, last] to class `cls` under a single lock.
+    void give_batch(size_t cls, FreeBlock* first, FreeBlock* last) noexcept {
+        Class& c = m_classes[cls];
+
+        std::lock_guard lock(c.mutex);
+        last->next = c.head;
+        c.head     = first;
+    }
+
+private:
+    [[nodiscard]] static FreeBlock* carve_slab(size_t cls, size_t n) {
+        const size_t size = size_class_bytes(cls);
+
+        std::byte* slab = static_cast<std::byte*>(
+            ::operator new(size * n, std::align_val_t(64)));
+
+        for (size_t i = 0; i + 1 < n; ++i) {
+            reinterpret_cast<FreeBlock*>(slab + i * size)->next
+                = reinterpret_cast<FreeBlock*>(slab + (i + 1) * size);
+        }
+
+        reinterpret_cast<FreeBlock*>(slab + (n - 1) * size)->next = nullptr;
+
+        return reinterpret_cast<FreeBlock*>(slab);
+    }
+};
+
+// Set on a thread once its ThreadCache is destroyed. Trivially destructible,
+// so it stays readable for the rest of the thread.
+inline thread_local bool thread_cache_destroyed = false;
+
+// Per thread free lists, one per size class. Allocating and freeing touch
+// only the calling thread's lists; a list that runs dry pulls a batch from
+// the SizeClassHeap and one that grows past two batches pushes a batch back.
+// Whatever is cached when the thread exits goes back to the heap.
+//
+// Thread locals are destroyed before statics, so containers with static
+// storage free after the cache is gone. allocate_block() and free_block()
+// go straight to the heap from then on.
+class ThreadCache {
+private:
+    struct Bin {
+        FreeBlock* head {nullptr};
+        size_t     count {0};
+    };
+
+    Bin m_bins[size_class_count];
+
+public:
+    ~ThreadCache() noexcept {
+        for (size_t cls = 0; cls < size_class_count; ++cls) {
+            Bin& bin = m_bins[cls];
+
+            if (bin.head != nullptr) {
+                flush(cls, bin.count);
+            }
+        }
+
+        thread_cache_destroyed = true;
+    }
+
+    ThreadCache() noexcept = default;
+
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache(ThreadCache&&)      = delete;
+
+    ThreadCache& operator=(const ThreadCache&) = delete;
+    ThreadCache& operator=(ThreadCache&&)      = delete;
+
+    [[nodiscard]] static ThreadCache& local() noexcept {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    [[nodiscard]] static void* allocate_block(size_t cls) {
+        if (!thread_cache_destroyed) {
+            return local().allocate(cls);
+        }
+
+        SizeClassHeap& heap  = SizeClassHeap::instance();
+        FreeBlock*     first = nullptr;
+
+        if (heap.take_batch(cls, first) > 1) {
+            FreeBlock* last = first->next;
+            while (last->next != nullptr) {
+                last = last->next;
+            }
+
+            heap.give_batch(cls, first->next, last);
+        }
+
+        return first;
+    }
+
+    static void free_block(size_t cls, void* p) noexcept {
+        if (!thread_cache_destroyed) {
+            local().deallocate(cls, p);
+            return;
+        }
+
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        SizeClassHeap::instance().give_batch(cls, block, block);
+    }
+
+public:
+    [[nodiscard]] void* allocate(size_t cls) {
+        Bin& bin = m_bins[cls];
+
+        if (bin.head == nullptr) {
+            bin.count = SizeClassHeap::instance().take_batch(cls, bin.head);
+        }
+
+        FreeBlock* block = bin.head;
+        bin.head         = block->next;
+        --bin.count;
+
+        return block;
+    }
+
+    void deallocate(size_t cls, void* p) noexcept {
+        Bin&       bin   = m_bins[cls];
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+
+        block->next = bin.head;
+        bin.head    = block;
+        ++bin.count;
+
+        if (bin.count >= 2 * size_class_batch(cls)) {
+            flush(cls, size_class_batch(cls));
+        }
+    }
+
+private:
+    // Hands the first `n` cached blocks of class `cls` back to the heap.
+    void flush(size_t cls, size_t n) noexcept {
+        Bin& bin = m_bins[cls];
+
+        FreeBlock* first = bin.head;
+        FreeBlock* last  = first;
+
+        for (size_t i = 1; i < n; ++i) {
+            last = last->next;
+        }
+
+        bin.head = last->next;
+        bin.count -= n;
+
+        SizeClassHeap::instance().give_batch(cls, first, last);
+    }
+};
+}
+
+// An allocator that serves blocks up to 1 MiB from power of two size classes
+// cached per thread, so threads building temporary arrays in parallel rarely
+// touch shared state. A block may be freed on a different thread than the
+// one that allocated it; it joins that thread's cache and flows back to the
+// shared pool in batches.
+//
+// allocate_at_least() reports the whole size class, so a DynamicArray grown
+// by doubling lands exactly on class boundaries and wastes nothing on top of
+// the rounding. Blocks are aligned to their size class, up to 64 bytes.
+template <typename T>
+class ThreadCacheAllocator {
+    static_assert(
+        alignof(T) <= alignof(std::max_align_t),
+        "ThreadCacheAllocator does not support over-aligned types");
+
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = ThreadCacheAllocator<U>;
+    };
+
+    constexpr ThreadCacheAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr ThreadCacheAllocator(const ThreadCacheAllocator<U>&) noexcept { }
+
+    template <typename U>
+    constexpr bool
+    operator==(const ThreadCacheAllocator<U>&) const noexcept {
+        return true;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) { return allocate_at_least(n).ptr; }
+
+    [[nodiscard]] AllocationResult<T*> allocate_at_least(size_t n) {
+        const size_t bytes = to_bytes(n);
+
+        if (bytes > internal::size_class_max_bytes) {
+            return AllocationResult<T*> {
+                .ptr   = static_cast<T*>(::operator new(bytes)),
+                .count = n,
+            };
+        }
+
+        const size_t cls = internal::size_class_of(bytes);
+
+        void* p = internal::ThreadCache::allocate_block(cls);
+
+        return AllocationResult<T*> {
+            .ptr   = static_cast<T*>(p),
+            .count = internal::size_class_bytes(cls) / sizeof(T),
+        };
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+
+        if (bytes > internal::size_class_max_bytes) {
+            ::operator delete(static_cast<void*>(p));
+            return;
+        }
+
+        internal::ThreadCache::free_block(
+            internal::size_class_of(bytes), static_cast<void*>(p));
+    }
+
+    [[nodiscard]] constexpr size_t max_size() const noexcept {
+        return std::numeric_limits<size_t>::max() / sizeof(T);
+    }
+
+private:
+    [[nodiscard]] static size_t to_bytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        return n * sizeof(T);
+    }
+};
+}
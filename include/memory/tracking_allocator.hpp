@@ -0,0 +1,258 @@
+// Copyright 2025 Jakub Kijek
+// Licensed under the MIT License.
+// See LICENSE.md file in the project root for full license information.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "../internal/type_traits.hpp"
+#include "aligned_allocator.hpp"
+
+namespace frank {
+// Allocation sizes are bucketed by bit width: bucket b counts blocks of
+// [2^(b-1), 2^b) bytes, with everything past the last bucket in the last one.
+inline constexpr size_t allocation_histogram_buckets = 40;
+
+// A point in time copy of AllocationStats.
+struct AllocationStatsSnapshot {
+    std::string_view label;
+    uint64_t         allocations {0};
+    uint64_t         deallocations {0};
+    uint64_t         bytes_allocated {0};
+    uint64_t         bytes_live {0};
+    uint64_t         bytes_peak {0};
+
+    std::array<uint64_t, allocation_histogram_buckets> histogram {};
+};
+
+// Counters for one label, shared by every TrackingAllocator that points at
+// it. All updates are relaxed atomics, so tracking costs a few uncontended
+// atomic adds per allocation and the numbers in a snapshot are only
+// consistent with each other once the tracked containers are quiet.
+class AllocationStats {
+private:
+    std::string m_label;
+
+    std::atomic<uint64_t> m_allocations {0};
+    std::atomic<uint64_t> m_deallocations {0};
+    std::atomic<uint64_t> m_bytes_allocated {0};
+    std::atomic<uint64_t> m_bytes_live {0};
+    std::atomic<uint64_t> m_bytes_peak {0};
+
+    std::array<std::atomic<uint64_t>, allocation_histogram_buckets>
+        m_histogram {};
+
+public:
+    ~AllocationStats() = default;
+
+    explicit AllocationStats(std::string label)
+        : m_label(std::move(label)) { }
+
+    AllocationStats(const AllocationStats&) = delete;
+    AllocationStats(AllocationStats&&)      = delete;
+
+    AllocationStats& operator=(const AllocationStats&) = delete;
+    AllocationStats& operator=(AllocationStats&&)      = delete;
+
+public:
+    void record_allocate(size_t bytes) noexcept {
+        constexpr auto relaxed = std::memory_order_relaxed;
+
+        m_allocations.fetch_add(1, relaxed);
+        m_bytes_allocated.fetch_add(bytes, relaxed);
+        m_histogram[bucket_of(bytes)].fetch_add(1, relaxed);
+
+        const uint64_t live = m_bytes_live.fetch_add(bytes, relaxed) + bytes;
+        uint64_t       peak = m_bytes_peak.load(relaxed);
+
+        while (live > peak
+               && !m_bytes_peak.compare_exchange_weak(peak, live, relaxed)) { }
+    }
+
+    void record_deallocate(size_t bytes) noexcept {
+        constexpr auto relaxed = std::memory_order_relaxed;
+
+        m_deallocations.fetch_add(1, relaxed);
+        m_bytes_live.fetch_sub(bytes, relaxed);
+    }
+
+    [[nodiscard]] AllocationStatsSnapshot snapshot() const noexcept {
+        constexpr auto relaxed = std::memory_order_relaxed;
+
+        AllocationStatsSnapshot s;
+        s.label           = m_label;
+        s.allocations     = m_allocations.load(relaxed);
+        s.deallocations   = m_deallocations.load(relaxed);
+        s.bytes_allocated = m_bytes_allocated.load(relaxed);
+        s.bytes_live      = m_bytes_live.load(relaxed);
+        s.bytes_peak      = m_bytes_peak.load(relaxed);
+
+        for (size_t b = 0; b < allocation_histogram_buckets; ++b) {
+            s.histogram[b] = m_histogram[b].load(relaxed);
+        }
+
+        return s;
+    }
+
+    [[nodiscard]] std::string_view label() const noexcept { return m_label; }
+
+    [[nodiscard]] static constexpr size_t bucket_of(size_t bytes) noexcept {
+        return std::min<size_t>(
+            std::bit_width(bytes), allocation_histogram_buckets - 1);
+    }
+};
+
+namespace internal {
+// Owns the AllocationStats handed out by allocation_stats(). Entries are
+// never removed, so references to them stay valid for the whole program.
+class AllocationStatsRegistry {
+private:
+    using Map = std::
+        map<std::string, std::unique_ptr<AllocationStats>, std::less<>>;
+
+    std::mutex m_mutex;
+    Map        m_stats;
+
+public:
+    [[nodiscard]] static AllocationStatsRegistry& instance() {
+        static AllocationStatsRegistry* registry
+            = new AllocationStatsRegistry();
+        return *registry;
+    }
+
+    [[nodiscard]] AllocationStats& get(std::string_view label) {
+        std::lock_guard lock(m_mutex);
+
+        auto it = m_stats.find(label);
+        if (it == m_stats.end()) {
+            it = m_stats
+                     .emplace(
+                         std::string(label),
+                         std::make_unique<AllocationStats>(std::string(label)))
+                     .first;
+        }
+
+        return *it->second;
+    }
+
+    template <typename F>
+    void for_each(F&& f) {
+        std::lock_guard lock(m_mutex);
+
+        for (const auto& [label, stats] : m_stats) {
+            f(stats->snapshot());
+        }
+    }
+};
+}
+
+// The process wide AllocationStats for `label`, created on first use. Meant
+// to be looked up once per container or system, not per allocation.
+[[nodiscard]] inline AllocationStats& allocation_stats(std::string_view label) {
+    return internal::AllocationStatsRegistry::instance().get(label);
+}
+
+// Calls `f` with a snapshot of every registered label, ordered by label.
+template <typename F>
+void for_each_allocation_stats(F&& f) {
+    internal::AllocationStatsRegistry::instance().for_each(std::forward<F>(f));
+}
+
+// Wraps `Upstream` and records every allocation and deallocation in an
+// AllocationStats. allocate_at_least() and reallocate() are passed through
+// when the upstream allocator has them, so wrapping an allocator does not
+// change how a DynamicArray grows.
+template <typename T, typename Upstream = std::allocator<T>>
+class TrackingAllocator {
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackingAllocator<
+            U,
+            typename std::allocator_traits<Upstream>::template rebind_alloc<U>>;
+    };
+
+private:
+    template <typename U, typename V>
+    friend class TrackingAllocator;
+
+    using Traits = std::allocator_traits<Upstream>;
+
+    [[no_unique_address]] Upstream m_upstream;
+    AllocationStats*               m_stats;
+
+public:
+    TrackingAllocator(AllocationStats& stats, const Upstream& upstream = {})
+        : m_upstream(upstream)
+        , m_stats(&stats) { }
+
+    template <typename U, typename V>
+    TrackingAllocator(const TrackingAllocator<U, V>& other)
+        : m_upstream(other.m_upstream)
+        , m_stats(other.m_stats) { }
+
+    template <typename U, typename V>
+    bool operator==(const TrackingAllocator<U, V>& other) const noexcept {
+        return m_stats == other.m_stats && m_upstream == other.m_upstream;
+    }
+
+public:
+    [[nodiscard]] T* allocate(size_t n) {
+        T* p = Traits::allocate(m_upstream, n);
+        m_stats->record_allocate(n * sizeof(T));
+
+        return p;
+    }
+
+    [[nodiscard]] AllocationResult<T*> allocate_at_least(size_t n)
+        requires internal::HasAllocateAtLeast<Upstream, size_t>
+    {
+        auto [p, count] = m_upstream.allocate_at_least(n);
+        m_stats->record_allocate(count * sizeof(T));
+
+        return AllocationResult<T*> {.ptr = p, .count = count};
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        m_stats->record_deallocate(n * sizeof(T));
+        Traits::deallocate(m_upstream, p, n);
+    }
+
+    [[nodiscard]] T* reallocate(T* p, size_t old_n, size_t new_n)
+        requires internal::HasReallocate<Upstream, T*, size_t>
+    {
+        T* q = m_upstream.reallocate(p, old_n, new_n);
+
+        m_stats->record_deallocate(old_n * sizeof(T));
+        m_stats->record_allocate(new_n * sizeof(T));
+
+        return q;
+    }
+
+    [[nodiscard]] AllocationStats& stats() const noexcept { return *m_stats; }
+
+    [[nodiscard]] const Upstream& upstream() const noexcept {
+        return m_upstream;
+    }
+};
+}